@@ -0,0 +1,87 @@
+#include "include/ArgParser/ArgParser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace ArgumentParser;
+
+namespace {
+std::size_t allocated_bytes = 0;
+}
+
+void* operator new(std::size_t size) {
+    allocated_bytes += size;
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000;
+
+    std::cout << "sizeof(StringArg): " << sizeof(StringArg) << std::endl;
+    std::cout << "sizeof(IntArg): " << sizeof(IntArg) << std::endl;
+    std::cout << "sizeof(FlagArg): " << sizeof(FlagArg) << std::endl;
+
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        names.push_back("option-" + std::to_string(i));
+
+    std::size_t before = allocated_bytes;
+    ArgParser parser("Benchmark");
+    for (std::size_t i = 0; i < count; ++i) {
+        switch (i % 4) {
+            case 0:
+                parser.AddStringArgument(names[i]).Default("value");
+                break;
+            case 1:
+                parser.AddIntArgument(names[i]).Default(42);
+                break;
+            case 2:
+                parser.AddStringArgument(names[i]).MultiValue();
+                break;
+            default:
+                parser.AddFlag(names[i]);
+                break;
+        }
+    }
+    std::size_t schema_bytes = allocated_bytes - before;
+
+    std::vector<std::string> args = {"app"};
+    for (std::size_t i = 2; i < count; i += 4)
+        args.push_back("--" + names[i] + "=x");
+    before = allocated_bytes;
+    if (!parser.Parse(args)) {
+        std::cerr << "Parse failed" << std::endl;
+        return 1;
+    }
+    std::size_t parse_bytes = allocated_bytes - before;
+
+    double best = 1e9;
+    std::size_t blob_size = 0;
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        auto start = std::chrono::steady_clock::now();
+        blob_size = parser.SaveSnapshot().size();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+
+    std::cout << "arguments: " << count << std::endl;
+    std::cout << "schema heap: " << schema_bytes << " bytes (" 
+              << schema_bytes / count << " per argument)" << std::endl;
+    std::cout << "parse heap: " << parse_bytes << " bytes" << std::endl;
+    std::cout << "scan (snapshot " << blob_size << " bytes): " << best * 1000 << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "include/ArgParser/ArgParser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace ArgumentParser;
+
+// Built twice: against the argparser library and against
+// argparser::header_only, so the two modes can be compared directly.
+template<typename Body>
+double NanosecondsPerIteration(std::size_t iterations, Body body) {
+    double best = 1e9;
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            body(i);
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count() / iterations);
+    }
+    return best;
+}
+
+void AddArguments(ArgParser& parser) {
+    parser.AddStringArgument('i', "input");
+    parser.AddIntArgument('j', "jobs").Default(1);
+    parser.AddFlag('v', "verbose");
+    parser.AddFlag('q', "quiet");
+    parser.AddStringArgument("files").MultiValue().Positional();
+}
+
+int main(int argc, char** argv) {
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+#ifdef ARGPARSER_HEADER_ONLY
+    std::cout << "mode: header-only" << std::endl;
+#else
+    std::cout << "mode: library" << std::endl;
+#endif
+
+    std::vector<std::string> args = {"app", "-vq", "--input=in.txt", "-j", "8", "a", "b", "c"};
+    int64_t checksum = 0;
+    double parse = NanosecondsPerIteration(iterations, [&](std::size_t) {
+        ArgParser parser("Benchmark");
+        AddArguments(parser);
+        checksum += parser.Parse(args);
+    });
+
+    ArgParser parser("Benchmark");
+    AddArguments(parser);
+    parser.Parse(args);
+    double lookup = NanosecondsPerIteration(iterations * 50, [&](std::size_t i) {
+        checksum += parser.GetFlag(i % 2 ? "verbose" : "quiet") + parser.GetIntValue("jobs");
+    });
+
+    std::vector<std::string_view> views(args.begin(), args.end());
+    double events = NanosecondsPerIteration(iterations, [&](std::size_t) {
+        for (const ParseEvent& event : parser.Events(views))
+            checksum += static_cast<int64_t>(event.kind);
+    });
+
+    std::cout << "register + parse: " << parse << " ns" << std::endl;
+    std::cout << "GetFlag + GetIntValue: " << lookup << " ns" << std::endl;
+    std::cout << "Events: " << events << " ns" << std::endl;
+    std::cout << "checksum: " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include "include/ArgParser/ArgParser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace ArgumentParser;
+
+double ParseSeconds(const std::vector<std::string>& args, std::size_t threads) {
+    double best = 1e9;
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        std::vector<int64_t> values;
+        ArgParser parser("Benchmark");
+        parser.AddIntArgument("N").MultiValue(1).Positional().StoreValues(values);
+        parser.SetConversionThreads(threads);
+
+        auto start = std::chrono::steady_clock::now();
+        if (!parser.Parse(args)) {
+            std::cerr << "Parse failed" << std::endl;
+            std::exit(1);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::vector<std::string> args = {"app"};
+    args.reserve(count + 1);
+    for (std::size_t i = 0; i < count; ++i)
+        args.push_back(std::to_string(i * 7919 % 1'000'000'007));
+
+    std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    double serial = ParseSeconds(args, 1);
+    std::cout << "tokens: " << count << std::endl;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        double seconds = threads == 1 ? serial : ParseSeconds(args, threads);
+        std::cout << "threads: " << threads 
+                  << "  time: " << seconds * 1000 << " ms" 
+                  << "  speedup: " << serial / seconds << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "include/ArgParser/ArgParser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+using namespace ArgumentParser;
+
+template<typename Validate>
+double GigabytesPerSecond(const std::string& payload, Validate validate) {
+    StringPolicy policy{.utf8 = true, .no_control = true};
+    double best = 1e9;
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        auto start = std::chrono::steady_clock::now();
+        if (validate(payload, policy).kind != StringViolationKind::kNone) {
+            std::cerr << "Validation failed" << std::endl;
+            std::exit(1);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return payload.size() / best / 1e9;
+}
+
+void Report(const char* name, const std::string& payload) {
+    std::cout << name << ":  simd: " << GigabytesPerSecond(payload, ValidateString) << " GB/s"
+              << "  scalar: " << GigabytesPerSecond(payload, ValidateStringScalar) << " GB/s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64 << 20;
+
+    std::string ascii;
+    while (ascii.size() < size)
+        ascii += "The quick brown fox jumps over the lazy dog. ";
+    std::string mixed;
+    while (mixed.size() < size)
+        mixed += "Съешь же ещё этих мягких французских булок, да выпей чаю. Plain ASCII text follows here. ";
+
+    std::cout << "payload: " << size << " bytes" << std::endl;
+    Report("ascii", ascii);
+    Report("mixed", mixed);
+
+    ArgParser parser("Benchmark");
+    parser.AddStringArgument("payload").Validate({.utf8 = true, .no_control = true});
+    std::vector<std::string> args = {"app", "--payload=" + ascii};
+    auto start = std::chrono::steady_clock::now();
+    if (!parser.Parse(args)) {
+        std::cerr << "Parse failed" << std::endl;
+        return 1;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "parse validated payload: " << elapsed.count() * 1000 << " ms" << std::endl;
+    return 0;
+}
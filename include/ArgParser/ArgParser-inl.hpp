@@ -0,0 +1,994 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "ArgParser/ArgParser.hpp"
+#endif
+
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "Parallel/ParallelFor.hpp"
+#include "Stream/StreamReader.hpp"
+#include "Tokenizer/Tokenizer.hpp"
+
+namespace ArgumentParser {
+ARGPARSER_INLINE ArgParser::ArgParser(std::string parser_name) 
+        : parser_name_(std::move(parser_name))
+        , short_help_name_('\0')
+        , has_help_(false) {}
+
+ARGPARSER_INLINE StringArg& ArgParser::AddStringArgument(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<StringArg>();
+}
+
+ARGPARSER_INLINE StringArg& ArgParser::AddStringArgument(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<StringArg>();
+}
+
+ARGPARSER_INLINE std::string ArgParser::GetStringValue(const std::string& full_name, std::size_t index) const {  
+    if (snapshot_.IsAttached())
+        return std::string(snapshot_.GetString(GetArgumentIndex(full_name, ArgumentType::kString), index));
+    return GetValueAs<std::string>(full_name, ArgumentType::kString, index);
+}
+
+ARGPARSER_INLINE IntArg& ArgParser::AddIntArgument(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<IntArg>();
+}
+
+ARGPARSER_INLINE IntArg& ArgParser::AddIntArgument(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<IntArg>();
+}
+
+ARGPARSER_INLINE int64_t ArgParser::GetIntValue(const std::string& full_name, std::size_t index) const {
+    if (snapshot_.IsAttached())
+        return snapshot_.GetInt(GetArgumentIndex(full_name, ArgumentType::kInt), index);
+    return GetValueAs<int64_t>(full_name, ArgumentType::kInt, index);
+}
+
+ARGPARSER_INLINE FlagArg& ArgParser::AddFlag(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<FlagArg>();
+}
+
+ARGPARSER_INLINE FlagArg& ArgParser::AddFlag(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<FlagArg>();
+}
+
+ARGPARSER_INLINE bool ArgParser::GetFlag(const std::string& full_name, std::size_t index) const {
+    if (snapshot_.IsAttached())
+        return snapshot_.GetFlag(GetArgumentIndex(full_name, ArgumentType::kFlag), index);
+    return GetValueAs<bool>(full_name, ArgumentType::kFlag, index);
+}
+
+ARGPARSER_INLINE DoubleArg& ArgParser::AddDoubleArgument(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<DoubleArg>();
+}
+
+ARGPARSER_INLINE DoubleArg& ArgParser::AddDoubleArgument(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<DoubleArg>();
+}
+
+ARGPARSER_INLINE double ArgParser::GetDoubleValue(const std::string& full_name, std::size_t index) const {
+    if (snapshot_.IsAttached())
+        return snapshot_.GetDouble(GetArgumentIndex(full_name, ArgumentType::kDouble), index);
+    return GetValueAs<double>(full_name, ArgumentType::kDouble, index);
+}
+
+ARGPARSER_INLINE UnsignedArg& ArgParser::AddUnsignedArgument(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<UnsignedArg>();
+}
+
+ARGPARSER_INLINE UnsignedArg& ArgParser::AddUnsignedArgument(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<UnsignedArg>();
+}
+
+ARGPARSER_INLINE uint64_t ArgParser::GetUnsignedValue(const std::string& full_name, std::size_t index) const {
+    if (snapshot_.IsAttached())
+        return snapshot_.GetUnsigned(GetArgumentIndex(full_name, ArgumentType::kUnsigned), index);
+    return GetValueAs<uint64_t>(full_name, ArgumentType::kUnsigned, index);
+}
+
+ARGPARSER_INLINE DurationArg& ArgParser::AddDurationArgument(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<DurationArg>();
+}
+
+ARGPARSER_INLINE DurationArg& ArgParser::AddDurationArgument(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<DurationArg>();
+}
+
+ARGPARSER_INLINE std::chrono::nanoseconds ArgParser::GetDurationValue(const std::string& full_name, std::size_t index) const {
+    if (snapshot_.IsAttached())
+        return std::chrono::nanoseconds(snapshot_.GetInt(GetArgumentIndex(full_name, ArgumentType::kDuration), index));
+    return GetValueAs<std::chrono::nanoseconds>(full_name, ArgumentType::kDuration, index);
+}
+
+ARGPARSER_INLINE ByteSizeArg& ArgParser::AddByteSizeArgument(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<ByteSizeArg>();
+}
+
+ARGPARSER_INLINE ByteSizeArg& ArgParser::AddByteSizeArgument(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<ByteSizeArg>();
+}
+
+ARGPARSER_INLINE uint64_t ArgParser::GetByteSizeValue(const std::string& full_name, std::size_t index) const {
+    if (snapshot_.IsAttached())
+        return snapshot_.GetUnsigned(GetArgumentIndex(full_name, ArgumentType::kByteSize), index);
+    return GetValueAs<ByteSize>(full_name, ArgumentType::kByteSize, index).bytes;
+}
+
+ARGPARSER_INLINE MapArg& ArgParser::AddMapArgument(char short_name, std::string full_name, std::string description) {
+    CheckShortName(short_name);
+    SetArgument(short_name, full_name, description);
+    return AddArgument<MapArg>();
+}
+
+ARGPARSER_INLINE MapArg& ArgParser::AddMapArgument(std::string full_name, std::string description) {
+    SetDescription(full_name, description);
+    return AddArgument<MapArg>();
+}
+
+ARGPARSER_INLINE const FlatMap& ArgParser::GetMap(const std::string& full_name) const {
+    static const FlatMap kEmpty;
+    std::size_t index = GetArgumentIndex(full_name, ArgumentType::kMap);
+    if (!arguments_[index])
+        return kEmpty;
+    return dynamic_cast<const MapArg&>(*arguments_[index]).GetValues();
+}
+
+ARGPARSER_INLINE std::optional<std::string_view> ArgParser::GetMapValue(const std::string& full_name, std::string_view key) const {
+    return GetMap(full_name).Find(key);
+}
+
+ARGPARSER_INLINE void ArgParser::AddHelp(char short_name, std::string full_name, std::string description) {
+    CheckNotFrozen();
+    CheckShortName(short_name);
+    short_help_name_ = short_name;
+    full_help_name_ = std::move(full_name);
+    name_index_.Clear();
+    help_description_ = std::move(description);
+}
+
+ARGPARSER_INLINE void ArgParser::SetConversionThreads(std::size_t threads) {
+    conversion_threads_ = threads;
+}
+
+ARGPARSER_INLINE void ArgParser::AllowAbbreviations(bool allow) {
+    allow_abbreviations_ = allow;
+}
+
+ARGPARSER_INLINE bool ArgParser::Help() const {
+    return has_help_;
+}
+
+ARGPARSER_INLINE const ParseError& ArgParser::Error() const {
+    return error_;
+}
+
+ARGPARSER_INLINE std::span<const std::string_view> ArgParser::Passthrough() const {
+    return passthrough_;
+}
+
+ARGPARSER_INLINE std::string ArgParser::HelpDescription() const {
+    std::string help_description 
+                        = parser_name_ + "\n" 
+                        + help_description_ + "\n\n";
+
+    std::vector<std::string_view> names = GetNames();
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        if (names[i].empty())
+            continue;
+        if (arguments_[i]) {
+            AppendHelpLine(help_description, names[i], *arguments_[i]);
+        } else {
+            AppendHelpLine(help_description, names[i], *CreateArgument(i));
+        }
+    }
+    help_description += "\n";
+    std::string help_symbol = std::string(1, short_help_name_);
+    help_description += "-" + help_symbol 
+                     + ",  --" + full_help_name_ 
+                     + " Display this help and exit\n";
+    return help_description;
+}
+
+ARGPARSER_INLINE void ArgParser::AppendHelpLine(std::string& help_description, std::string_view full_name, 
+                               const BaseArgument& arg) const {
+    std::string short_name;
+    if (char symbol = GetShortName(full_name)) {
+        short_name = "-" + std::string(1, symbol) + ",  ";
+    } else {
+        short_name = "     ";
+    }
+    std::string long_name = "--" + std::string(full_name);
+    if (arg.GetType() != ArgumentType::kFlag)
+        long_name += "=<" + kTypeNames.at(arg.GetType()) + ">";
+    long_name += ",  ";
+
+    std::string_view description = GetDescription(full_name);
+    std::string full_description = std::string(description) + (description.empty() ? "" : " ");
+    if (arg.IsMultiValue() || arg.IsPositional() || arg.HasDefault()) {
+        full_description += "[";
+        bool need_comma = false;
+        if (arg.IsMultiValue()) {
+            full_description += "repeated, min args = " + std::to_string(arg.min_args());
+            if (arg.max_args() != BaseArgument::kUnlimited)
+                full_description += ", max args = " + std::to_string(arg.max_args());
+            need_comma = true;
+        }
+        if (arg.IsPositional()) {
+            if (need_comma) 
+                full_description += ", ";
+            full_description += "positional";
+            if (arg.IsFromStream())
+                full_description += ", '-' reads from stream";
+            need_comma = true;
+        }
+        if (arg.HasDefault()) {
+            if (need_comma) 
+                full_description += ", ";
+            full_description += "default = " + arg.GetDefault();
+        }
+        full_description += "]";
+    }
+
+    help_description += short_name + long_name + full_description + "\n";
+}
+
+ARGPARSER_INLINE bool ArgParser::Parse(int argc, char** argv) {
+    tokens_.assign(argv, argv + argc);
+    return ParseTokens(tokens_);
+}
+
+ARGPARSER_INLINE bool ArgParser::Parse(const std::vector<std::string>& args) {
+    tokens_.assign(args.begin(), args.end());
+    return ParseTokens(tokens_);
+}
+
+ARGPARSER_INLINE void ArgParser::Reset() {
+    for (ArgPtr& argument : arguments_) {
+        if (argument)
+            argument->ClearValues();
+    }
+    snapshot_.Detach();
+    has_help_ = false;
+    ClearError();
+    passthrough_.clear();
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseCommandLine(std::string_view command_line) {
+    ClearError();
+    command_line_.assign(command_line);
+    if (!TokenizeCommandLine(command_line_, tokens_)) {
+        std::cerr << "Unterminated quote in command line" << std::endl;
+        return SetError(ParseErrorKind::kInvalidFormat, {});
+    }
+    return ParseTokens(tokens_);
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseTokens(std::span<const std::string_view> args) {
+    // Bound variables start every parse at their default, so a parser that
+    // was Reset behaves like a fresh one.
+    for (ArgPtr& argument : arguments_) {
+        if (argument)
+            argument->StoreDefault();
+    }
+    for (const ParseEvent& event : Events(args)) {
+        if (!ApplyEvent(event))
+            return false;
+        if (Help())
+            return true;
+    }
+    return Help() || (IsCorrectMultiValue() && AllHaveValues());
+}
+
+ARGPARSER_INLINE ArgParser::EventsGuard::EventsGuard(bool& active) : active_(&active) {
+    if (active)
+        throw std::logic_error("Another Events() generator of this parser is still alive");
+    active = true;
+}
+
+ARGPARSER_INLINE ArgParser::EventsGuard::EventsGuard(EventsGuard&& other) noexcept
+        : active_(std::exchange(other.active_, nullptr)) {}
+
+ARGPARSER_INLINE ArgParser::EventsGuard::~EventsGuard() {
+    if (active_)
+        *active_ = false;
+}
+
+ARGPARSER_INLINE Generator<ParseEvent> ArgParser::Events(std::span<const std::string_view> args) {
+    FrameBuffer::Scope frame(frame_buffer_);
+    return RunEvents(args, EventsGuard(events_active_));
+}
+
+ARGPARSER_INLINE Generator<ParseEvent> ArgParser::RunEvents(std::span<const std::string_view> args, EventsGuard) {
+    snapshot_.Detach();
+    ClearError();
+    passthrough_.clear();
+    positional_cursor_ = 0;
+    positional_taken_ = 0;
+    for (size_t i = 1; i < args.size(); ++i) {
+        std::string_view arg = args[i];
+        if (arg == "--") {
+            co_yield ParseEvent{ParseEventKind::kPassthrough, arg, {}, SchemaView::kNotFound, {}, args.subspan(i + 1)};
+            co_return;
+        }
+        if (arg == "-" && IsStreamPositional()) {
+            auto [index, name] = positionals_[positional_cursor_];
+            BaseArgument& argument = *GetArgument(index);
+            StreamReader reader(argument.GetStreamFd(), argument.GetStreamDelimiter());
+            std::size_t limit = argument.IsMultiValue() ? argument.max_args() : 1;
+            std::string_view token;
+            while (reader.Next(token)) {
+                if (!token.empty() && token.back() == '\r')
+                    token.remove_suffix(1);
+                if (token.empty())
+                    continue;
+                if (positional_taken_ == limit) {
+                    std::cerr << "Too many values in stream for argument: " << name << std::endl;
+                    SetError(ParseErrorKind::kTooManyValues, name);
+                    co_yield ParseEvent{ParseEventKind::kError, error_.argument};
+                    co_return;
+                }
+                ++positional_taken_;
+                co_yield ParseEvent{ParseEventKind::kPositional, name, argument.GetType(), index, {}, {&token, 1}};
+            }
+            if (reader.HasError()) {
+                std::cerr << "Failed to read values from stream for argument: " << name << std::endl;
+                SetError(ParseErrorKind::kStreamError, name);
+                co_yield ParseEvent{ParseEventKind::kError, error_.argument};
+                co_return;
+            }
+            continue;
+        }
+
+        pending_events_.clear();
+        bool parsed;
+        if (arg.size() < 2 || arg[0] != '-') {
+            parsed = ParsePositionalArgument(args, i);
+        } else if (arg[1] == '-') {
+            parsed = ParseFullArgument(args, i);
+        } else {
+            parsed = ParseShortArgument(args, i);
+        }
+        for (std::size_t j = 0; j < pending_events_.size(); ++j) {
+            co_yield pending_events_[j];
+            if (pending_events_[j].kind == ParseEventKind::kHelp)
+                co_return;
+        }
+        if (!parsed) {
+            co_yield ParseEvent{ParseEventKind::kError, error_.argument};
+            co_return;
+        }
+    }
+}
+
+ARGPARSER_INLINE bool ArgParser::ApplyEvent(const ParseEvent& event) {
+    switch (event.kind) {
+        case ParseEventKind::kOption:
+            if (!event.values.empty())
+                return ParseValueRun(GetArgument(event.index), event.name, event.values);
+            return StoreOptionValue(*GetArgument(event.index), event.name, event.value);
+        case ParseEventKind::kPositional:
+            return ParseValueRun(GetArgument(event.index), event.name, event.values);
+        case ParseEventKind::kPassthrough:
+            passthrough_.assign(event.values.begin(), event.values.end());
+            return true;
+        case ParseEventKind::kHelp:
+            has_help_ = true;
+            return true;
+        case ParseEventKind::kError:
+            return false;
+    }
+    return true;
+}
+
+ARGPARSER_INLINE void ArgParser::PushEvent(ParseEventKind kind, std::size_t index, std::string_view name, 
+                          std::string_view value, std::span<const std::string_view> values) {
+    ArgumentType type = index == SchemaView::kNotFound ? ArgumentType{} : GetArgumentType(index);
+    pending_events_.push_back(ParseEvent{kind, name, type, index, value, values});
+}
+
+ARGPARSER_INLINE void ArgParser::PushHelpEvent() {
+    PushEvent(ParseEventKind::kHelp, SchemaView::kNotFound, full_help_name_);
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseShortArgument(std::span<const std::string_view> args, size_t& i) {
+    std::string_view arg = args[i];
+    std::size_t equal_pos = arg.find('=');
+    ValidationResult validation_result = ValidateShortArgument(arg, equal_pos);
+    if (validation_result == ValidationResult::kHandled)
+        return true;
+    if (validation_result == ValidationResult::kError)
+        return false;
+    
+    char short_name = arg[1];
+    validation_result = ValidateShortName(short_name);
+    if (validation_result == ValidationResult::kHandled)
+        return true;
+    if (validation_result == ValidationResult::kError)
+        return false;
+    
+    std::string_view full_name = FindShortArgument(short_name);
+    std::size_t argument_index = FindArgument(full_name);
+    BaseArgument& argument = *GetArgument(argument_index);
+    ParseContext context{args, full_name, argument, argument_index, i, equal_pos, equal_pos != std::string_view::npos};
+    return ParseArgument(context);
+}
+
+ARGPARSER_INLINE ArgParser::ValidationResult ArgParser::ValidateShortName(char short_name) {
+    if (FindShortArgument(short_name).empty()) {
+        if (short_name == short_help_name_) {
+            PushHelpEvent();
+            return ValidationResult::kHandled;
+        }
+        std::cerr << "Unknown short argument: " << short_name << std::endl;
+        SetError(ParseErrorKind::kUnknownArgument, std::string_view(&short_name, 1));
+        return ValidationResult::kError;
+    }
+    return ValidationResult::kValid;
+}
+
+ARGPARSER_INLINE auto ArgParser::ValidateShortArgument(std::string_view arg, std::size_t equal_pos) 
+        -> ArgParser::ValidationResult {
+    bool is_named = (equal_pos != std::string_view::npos);
+    if (arg.size() < 2 || (is_named && equal_pos < 2)) {
+        std::cerr << "Invalid short argument format: " << arg << std::endl;
+        SetError(ParseErrorKind::kInvalidFormat, arg);
+        return ValidationResult::kError;
+    }
+    if (!is_named && arg.size() > 2) {
+        if (!ParseShortFlags(arg))
+            return ValidationResult::kError;
+        return ValidationResult::kHandled;
+    } 
+    if (is_named && equal_pos != 2) {
+        std::cerr << "Invalid short argument format: " << arg << std::endl;
+        SetError(ParseErrorKind::kInvalidFormat, arg);
+        return ValidationResult::kError;
+    }
+    return ValidationResult::kValid;
+}
+
+ARGPARSER_INLINE bool ArgParser::NextValueExists(ParseContext& ctx) const {
+    return ctx.is_named || ctx.index + 1 < ctx.args.size();
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseTypeArgument(ParseContext& context) {
+    if (context.argument.GetType() == ArgumentType::kFlag)
+        return ParseFlagArgument(context);
+    return ParseValueArgument(context);
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseMultivalue(ParseContext& context) {
+    if (context.argument.GetType() == ArgumentType::kFlag)
+        return ParseFlagArgument(context);
+    if (!NextValueExists(context))
+        return true;
+
+    std::size_t begin = context.index + 1;
+    std::size_t end = begin + 1;
+    while (end < context.args.size() && !context.args[end].starts_with('-'))
+        ++end;
+    PushEvent(ParseEventKind::kOption, context.argument_index, context.full_name, 
+              {}, context.args.subspan(begin, end - begin));
+    context.index = end - 1;
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseArgument(ParseContext& context) {
+    if (context.is_named || !context.argument.IsMultiValue())
+        return ParseTypeArgument(context);
+    return ParseMultivalue(context);
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseValueArgument(ParseContext& ctx) {
+    if (!NextValueExists(ctx)) {
+        std::cerr << "Expected value for argument: " << ctx.full_name << std::endl;
+        return SetError(ParseErrorKind::kMissingValue, ctx.full_name);
+    }
+
+    std::string_view value = ctx.is_named
+                             ? ctx.args[ctx.index].substr(ctx.equal_pos + 1)
+                             : ctx.args[++ctx.index];
+    PushEvent(ParseEventKind::kOption, ctx.argument_index, ctx.full_name, value);
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseFlagArgument(ParseContext& ctx) {
+    if (ctx.is_named) {
+        std::cerr << "Flag can not be named argument: " << ctx.full_name << std::endl;
+        return SetError(ParseErrorKind::kInvalidFormat, ctx.full_name);
+    }
+    PushEvent(ParseEventKind::kOption, ctx.argument_index, ctx.full_name);
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::StoreOptionValue(BaseArgument& argument, std::string_view full_name, std::string_view value) {
+    if (argument.GetType() == ArgumentType::kMap)
+        return StoreMapValue(dynamic_cast<MapArg&>(argument), full_name, value);
+    return VisitType(argument.GetType(), [&]<typename T>(std::type_identity<T>) {
+        if constexpr (std::is_same_v<T, bool>) {
+            dynamic_cast<FlagArg&>(argument).AddValue(true);
+            return true;
+        } else {
+            return StoreValue(dynamic_cast<Argument<T>&>(argument), full_name, value);
+        }
+    });
+}
+
+template<typename T>
+bool ArgParser::StoreValue(Argument<T>& argument, std::string_view full_name, std::string_view str) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (!CheckStringValue(argument, full_name, str))
+            return false;
+    }
+    T value;
+    if (!ConvertValue(str, value)) {
+        std::cerr << "Invalid " << kTypeNames.at(ArgumentTypeOf<T>()) 
+                  << " value for argument: " << full_name << std::endl;
+        return SetError(ParseErrorKind::kInvalidValue, full_name);
+    }
+    argument.AddValue(std::move(value));
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::CheckStringValue(const StringArg& argument, std::string_view full_name, std::string_view value) {
+    const StringPolicy* policy = argument.GetPolicy();
+    if (!policy)
+        return true;
+    StringViolation violation = ValidateString(value, *policy);
+    switch (violation.kind) {
+        case StringViolationKind::kNone:
+            return true;
+        case StringViolationKind::kTooLong:
+            std::cerr << "Value longer than " << policy->max_length << " bytes for argument: " << full_name << std::endl;
+            break;
+        case StringViolationKind::kInvalidUtf8:
+            std::cerr << "Invalid UTF-8 at byte " << violation.offset << " for argument: " << full_name << std::endl;
+            break;
+        case StringViolationKind::kControlCharacter:
+            std::cerr << "Control character at byte " << violation.offset << " for argument: " << full_name << std::endl;
+            break;
+    }
+    SetError(ParseErrorKind::kInvalidValue, full_name);
+    error_.offset = violation.offset;
+    return false;
+}
+
+ARGPARSER_INLINE bool ArgParser::StoreMapValue(MapArg& argument, std::string_view full_name, std::string_view pair) {
+    std::size_t separator = pair.find('=');
+    if (separator == std::string_view::npos || separator == 0) {
+        std::cerr << "Expected key=value for argument: " << full_name << std::endl;
+        return SetError(ParseErrorKind::kInvalidValue, full_name);
+    }
+    if (!argument.AddPair(pair.substr(0, separator), pair.substr(separator + 1))) {
+        std::cerr << "Duplicate key " << pair.substr(0, separator) << " for argument: " << full_name << std::endl;
+        return SetError(ParseErrorKind::kDuplicateKey, full_name);
+    }
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseFullArgument(std::span<const std::string_view> args, size_t& i) {
+    std::string_view arg = args[i];
+    std::size_t equal_pos = arg.find('=');
+    bool is_named = equal_pos != std::string_view::npos;
+    if (!is_named && arg.substr(2) == full_help_name_) {
+        PushHelpEvent();
+        return true;
+    }
+
+    std::string_view full_name = is_named 
+                                 ? arg.substr(2, equal_pos - 2)
+                                 : arg.substr(2);
+
+    std::size_t argument_index = FindArgument(full_name);
+    if (argument_index == SchemaView::kNotFound && allow_abbreviations_) {
+        ValidationResult validation_result = ResolveAbbreviation(full_name, is_named);
+        if (validation_result == ValidationResult::kHandled)
+            return true;
+        if (validation_result == ValidationResult::kError)
+            return false;
+        argument_index = FindArgument(full_name);
+    }
+    if (argument_index == SchemaView::kNotFound) {
+        std::cerr << "Unknown argument: " << full_name << std::endl;
+        SetError(ParseErrorKind::kUnknownArgument, full_name);
+        SuggestNames(full_name);
+        return false;
+    }
+
+    ParseContext context{args, full_name, *GetArgument(argument_index), argument_index, i, equal_pos, is_named};
+    return ParseArgument(context);
+}
+
+ARGPARSER_INLINE auto ArgParser::ResolveAbbreviation(std::string_view& full_name, bool is_named) 
+        -> ArgParser::ValidationResult {
+    // An empty name is a prefix of everything, not an abbreviation.
+    if (full_name.empty())
+        return ValidationResult::kValid;
+    BuildNameIndex();
+    std::span<const std::string_view> candidates = name_index_.FindPrefix(full_name);
+    if (candidates.size() == 1) {
+        if (!is_named && candidates[0] == full_help_name_) {
+            PushHelpEvent();
+            return ValidationResult::kHandled;
+        }
+        full_name = candidates[0];
+        return ValidationResult::kValid;
+    }
+    if (candidates.size() > 1) {
+        std::cerr << "Ambiguous argument: " << full_name << ", candidates:";
+        for (std::string_view candidate : candidates)
+            std::cerr << " --" << candidate;
+        std::cerr << std::endl;
+        SetError(ParseErrorKind::kAmbiguousArgument, full_name);
+        error_.suggestions.assign(candidates.begin(), candidates.end());
+        return ValidationResult::kError;
+    }
+    return ValidationResult::kValid;
+}
+
+ARGPARSER_INLINE bool ArgParser::ParsePositionalArgument(std::span<const std::string_view> args, size_t& i) {
+    BuildPositionals();
+    std::size_t end = i + 1;
+    while (end < args.size() && !args[end].starts_with('-'))
+        ++end;
+    std::span<const std::string_view> run = args.subspan(i, end - i);
+    i = end - 1;
+
+    while (!run.empty()) {
+        if (positional_cursor_ == positionals_.size()) {
+            if (positionals_.empty()) {
+                std::cerr << "No positional argument defined." << std::endl;
+            } else {
+                std::cerr << "Too many positional arguments: " << run[0] << std::endl;
+            }
+            return SetError(ParseErrorKind::kUnknownArgument, run[0]);
+        }
+        auto [index, name] = positionals_[positional_cursor_];
+        const BaseArgument& argument = *GetArgument(index);
+        std::size_t limit = argument.IsMultiValue() ? argument.max_args() : 1;
+        std::size_t count = std::min(limit - positional_taken_, run.size());
+        PushEvent(ParseEventKind::kPositional, index, name, {}, run.first(count));
+        run = run.subspan(count);
+        positional_taken_ += count;
+        if (positional_taken_ == limit) {
+            ++positional_cursor_;
+            positional_taken_ = 0;
+        }
+    }
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::IsStreamPositional() {
+    BuildPositionals();
+    return positional_cursor_ < positionals_.size() 
+           && GetArgument(positionals_[positional_cursor_].first)->IsFromStream();
+}
+
+ARGPARSER_INLINE void ArgParser::BuildPositionals() {
+    if (positionals_built_)
+        return;
+    std::vector<std::string_view> names = GetNames();
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        bool is_positional = arguments_[i] ? arguments_[i]->IsPositional() 
+                                           : schema_.GetRecord(i).flags & SchemaView::kPositional;
+        if (is_positional)
+            positionals_.emplace_back(i, names[i]);
+    }
+    positionals_built_ = true;
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseValueRun(ArgPtr& argument, std::string_view full_name, 
+                              std::span<const std::string_view> run) {
+    if (run.size() >= kParallelThreshold) {
+        std::optional<bool> result = VisitType(argument->GetType(), [&]<typename T>(std::type_identity<T>) {
+            if constexpr (!std::is_same_v<T, std::string> && !std::is_same_v<T, bool>) {
+                auto& typed_argument = dynamic_cast<Argument<T>&>(*argument);
+                if (!typed_argument.HasOnValue())
+                    return std::optional<bool>{ParseConvertedRun(typed_argument, full_name, run)};
+            }
+            return std::optional<bool>{};
+        });
+        if (result)
+            return *result;
+    }
+    for (std::string_view value : run) {
+        if (!ParsePositionalValue(argument, full_name, value))
+            return false;
+    }
+    return true;
+}
+
+template<typename T>
+bool ArgParser::ParseConvertedRun(Argument<T>& argument, std::string_view full_name, 
+                                  std::span<const std::string_view> run) {
+    std::size_t threads = conversion_threads_ ? conversion_threads_ 
+                                              : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t size = argument.GetStoredCount();
+    std::span<T> slots = argument.AppendValues(run.size());
+    std::size_t error;
+    try {
+        error = ParallelFor(run.size(), threads, kParallelChunk, 
+                            [run, slots](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                if (!ConvertValue(run[i], slots[i]))
+                    return i;
+            }
+            return end;
+        });
+    } catch (...) {
+        argument.ResizeValues(size);
+        throw;
+    }
+    if (error == run.size())
+        return true;
+
+    argument.ResizeValues(size + error);
+    std::cerr << "Invalid " << kTypeNames.at(ArgumentTypeOf<T>()) << " value for argument: " 
+              << full_name << std::endl;
+    return SetError(ParseErrorKind::kInvalidValue, full_name);
+}
+
+ARGPARSER_INLINE bool ArgParser::ParsePositionalValue(ArgPtr& argument, std::string_view full_name, std::string_view value) {
+    if (argument->GetType() == ArgumentType::kMap)
+        return StoreMapValue(dynamic_cast<MapArg&>(*argument), full_name, value);
+    return VisitType(argument->GetType(), [&]<typename T>(std::type_identity<T>) {
+        if constexpr (std::is_same_v<T, bool>) {
+            return ParsePositionalFlagArgument(full_name);
+        } else {
+            return ParsePositionalValueArgument<T>(argument, full_name, value);
+        }
+    });
+}
+
+template<typename T>
+bool ArgParser::ParsePositionalValueArgument(ArgPtr& argument, std::string_view full_name, std::string_view str) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (!CheckStringValue(dynamic_cast<StringArg&>(*argument), full_name, str))
+            return false;
+    }
+    T value;
+    if (!ConvertValue(str, value)) {
+        std::cerr << "Invalid " << kTypeNames.at(ArgumentTypeOf<T>()) << " value for argument: " 
+                    << full_name << std::endl;
+        return SetError(ParseErrorKind::kInvalidValue, full_name);
+    }
+    dynamic_cast<Argument<T>&>(*argument).AddValue(std::move(value));
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::ParsePositionalFlagArgument(std::string_view full_name) {
+    std::cerr << "Flag is not supported for positional arguments." << std::endl;
+    return SetError(ParseErrorKind::kInvalidFormat, full_name);
+}
+
+ARGPARSER_INLINE bool ArgParser::IsCorrectMultiValue() {
+    for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        const ArgPtr& argument = arguments_[i];
+        if (!argument) {
+            SchemaView::Record record = schema_.GetRecord(i);
+            if ((record.flags & SchemaView::kMultiValue) && record.min_args > 0) {
+                std::cerr << "Multi-value argument" << "has incorrect number of values." << std::endl;
+                return SetError(ParseErrorKind::kNotEnoughValues, GetNames()[i]);
+            }
+            continue;
+        }
+        if (argument->IsMultiValue() && argument->min_args() > argument->GetArgCount()) {
+            std::cerr << "Multi-value argument" << "has incorrect number of values." << std::endl;
+            return SetError(ParseErrorKind::kNotEnoughValues, GetNames()[i]);
+        }
+        if (argument->IsMultiValue() && argument->max_args() < argument->GetArgCount()) {
+            std::cerr << "Multi-value argument has too many values." << std::endl;
+            return SetError(ParseErrorKind::kTooManyValues, GetNames()[i]);
+        }
+    }
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::AllHaveValues() {
+    for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        const ArgPtr& argument = arguments_[i];
+        if (!argument) {
+            SchemaView::Record record = schema_.GetRecord(i);
+            auto type = static_cast<ArgumentType>(record.type);
+            if (!(record.flags & (SchemaView::kHasDefault | SchemaView::kPositional))
+                    && type != ArgumentType::kFlag && type != ArgumentType::kMap) {
+                return SetError(ParseErrorKind::kMissingArgument, GetNames()[i]);
+            }
+            continue;
+        }
+        if (!argument->has_value() && !argument->IsPositional() 
+                                   && argument->GetType() != ArgumentType::kFlag) {
+            return SetError(ParseErrorKind::kMissingArgument, GetNames()[i]);
+        }
+    }
+    return true;
+}
+
+ARGPARSER_INLINE bool ArgParser::ParseShortFlags(std::string_view arg) {
+    for (size_t i = 1; i < arg.size(); ++i) {
+        char flag = arg[i];
+        if (flag == short_help_name_) {
+            PushHelpEvent();
+            return true;
+        }
+        std::string_view full_name = FindShortArgument(flag);
+        if (full_name.empty()) {
+            std::cerr << "Unknown flag: " << flag << std::endl;
+            return SetError(ParseErrorKind::kUnknownArgument, std::string_view(&arg[i], 1));
+        }
+        PushEvent(ParseEventKind::kOption, FindArgument(full_name), full_name);
+    }
+    return true;
+}
+
+ARGPARSER_INLINE std::size_t ArgParser::FindArgument(std::string_view full_name) const {
+    if (schema_.IsAttached())
+        return schema_.Find(full_name);
+    auto it = argument_indices_.find(full_name);
+    return it == argument_indices_.end() ? SchemaView::kNotFound : it->second;
+}
+
+ARGPARSER_INLINE std::string_view ArgParser::FindShortArgument(char short_name) const {
+    if (schema_.IsAttached()) {
+        std::size_t index = schema_.FindShort(short_name);
+        if (index == SchemaView::kNotFound)
+            return {};
+        return schema_.GetString(schema_.GetRecord(index).name);
+    }
+    auto it = full_names_.find(short_name);
+    return it == full_names_.end() ? std::string_view{} : std::string_view{it->second};
+}
+
+ARGPARSER_INLINE std::vector<std::string_view> ArgParser::GetNames() const {
+    std::vector<std::string_view> names(arguments_.size());
+    if (schema_.IsAttached()) {
+        for (std::size_t i = 0; i < names.size(); ++i)
+            names[i] = schema_.GetString(schema_.GetRecord(i).name);
+        return names;
+    }
+    for (const auto& [full_name, index] : argument_indices_)
+        names[index] = full_name;
+    return names;
+}
+
+ARGPARSER_INLINE std::string_view ArgParser::GetDescription(std::string_view full_name) const {
+    if (schema_.IsAttached())
+        return schema_.GetString(schema_.GetRecord(schema_.Find(full_name)).description);
+    auto it = descriptions_.find(std::string(full_name));
+    return it == descriptions_.end() ? std::string_view{} : std::string_view{it->second};
+}
+
+ARGPARSER_INLINE ArgumentType ArgParser::GetArgumentType(std::size_t index) const {
+    if (arguments_[index])
+        return arguments_[index]->GetType();
+    return static_cast<ArgumentType>(schema_.GetRecord(index).type);
+}
+
+ARGPARSER_INLINE std::size_t ArgParser::GetArgumentIndex(std::string_view full_name, ArgumentType expected_type) const {
+    std::size_t index = FindArgument(full_name);
+    if (index == SchemaView::kNotFound)
+        throw std::invalid_argument("Unknown argument: " + std::string(full_name));
+    if (GetArgumentType(index) != expected_type)
+        throw std::invalid_argument(std::format("Argument is not of type {}", kTypeNames.at(expected_type)));
+    return index;
+}
+
+ARGPARSER_INLINE char ArgParser::GetShortName(std::string_view full_name) const {
+    if (schema_.IsAttached())
+        return schema_.GetRecord(schema_.Find(full_name)).short_name;
+    auto it = short_names_.find(std::string(full_name));
+    if (it != short_names_.end()) {
+        return it->second;
+    }
+    return '\0';
+}
+
+ARGPARSER_INLINE auto ArgParser::GetArgument(std::string_view full_name) 
+        -> std::unique_ptr<BaseArgument>& {
+    std::size_t index = FindArgument(full_name);
+    if (index == SchemaView::kNotFound)
+        throw std::invalid_argument("Unknown argument: " + std::string(full_name));
+    return GetArgument(index);
+}
+
+ARGPARSER_INLINE auto ArgParser::GetArgument(std::size_t index) 
+        -> std::unique_ptr<BaseArgument>& {
+    ArgPtr& argument = arguments_[index];
+    if (!argument)
+        argument = CreateArgument(index);
+    return argument;
+}
+
+ARGPARSER_INLINE void ArgParser::SetNames(char short_name, const std::string& full_name) {
+    short_names_[full_name] = short_name;
+    full_names_[short_name] = full_name;
+}
+
+ARGPARSER_INLINE void ArgParser::SetDescription(std::string& full_name, std::string& description) {
+    CheckNotFrozen();
+    name_index_.Clear();
+    positionals_.clear();
+    positionals_built_ = false;
+    descriptions_[full_name] = std::move(description);
+    argument_indices_[std::move(full_name)] = arguments_.size();
+}
+
+ARGPARSER_INLINE void ArgParser::SetArgument(char short_name, std::string& full_name, std::string& description) {
+    CheckNotFrozen();
+    SetNames(short_name, full_name);
+    SetDescription(full_name, description);
+}
+
+ARGPARSER_INLINE void ArgParser::CheckShortName(char short_name) const {
+    if (!isalpha(short_name))
+        throw std::invalid_argument("Short name must be a single alphabetic character");
+}
+
+ARGPARSER_INLINE bool ArgParser::SetError(ParseErrorKind kind, std::string_view argument) {
+    error_.kind = kind;
+    error_.argument = argument;
+    error_.suggestions.clear();
+    error_.offset = 0;
+    return false;
+}
+
+ARGPARSER_INLINE void ArgParser::ClearError() {
+    error_.kind = ParseErrorKind::kNone;
+    error_.argument.clear();
+    error_.suggestions.clear();
+    error_.offset = 0;
+}
+
+ARGPARSER_INLINE void ArgParser::BuildNameIndex() {
+    if (name_index_.IsBuilt())
+        return;
+    std::vector<std::string_view> names = GetNames();
+    if (!full_help_name_.empty())
+        names.push_back(full_help_name_);
+    name_index_.Build(std::move(names));
+}
+
+ARGPARSER_INLINE void ArgParser::SuggestNames(std::string_view full_name) {
+    BuildNameIndex();
+    std::vector<std::string_view> suggestions = name_index_.Suggest(full_name);
+    if (suggestions.empty())
+        return;
+
+    std::cerr << "Did you mean:";
+    for (std::string_view suggestion : suggestions) {
+        std::cerr << " --" << suggestion;
+        error_.suggestions.emplace_back(suggestion);
+    }
+    std::cerr << std::endl;
+}
+
+ARGPARSER_INLINE void ArgParser::CheckNotFrozen() const {
+    if (schema_.IsAttached())
+        throw std::logic_error("Cannot add arguments to a parser built from a frozen schema");
+}
+}
\ No newline at end of file
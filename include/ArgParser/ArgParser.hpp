@@ -1,21 +1,50 @@
 #pragma once
 
-#include <charconv>
+#include <chrono>
 #include <cstdint>
 #include <format>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "ArgParser/Config.hpp"
+#include "ArgParser/ParseError.hpp"
+#include "ArgParser/ParseEvent.hpp"
 #include "Argument/Argument.hpp"
+#include "Argument/MapArgument.hpp"
+#include "Generator/Generator.hpp"
+#include "NameIndex/NameIndex.hpp"
+#include "Schema/Schema.hpp"
+#include "Snapshot/Snapshot.hpp"
 
 namespace ArgumentParser {
 class ArgParser {
 public:
     ArgParser(std::string);
+    // Borrows `schema`: the blob must outlive the parser.
+    explicit ArgParser(std::span<const std::byte> schema);
+    // Takes ownership of a blob, e.g. straight from FreezeSchema().
+    explicit ArgParser(std::vector<std::byte>&& schema);
     
     bool Parse(const std::vector<std::string>&);
     bool Parse(int argc, char** argv);
+    bool ParseCommandLine(std::string_view);
+    // Forgets the values, help request, error and passthrough of previous
+    // parses. Registrations and allocated capacity are kept, so a fixed
+    // schema can be re-run without allocating.
+    void Reset();
+
+    // Lazily resolves `args` (args[0] is the program name) into events
+    // without storing any values. Parse is a consumer of this stream that
+    // converts and stores every value and then validates the result. The
+    // parser and `args` must outlive the generator. The generator keeps its
+    // state in the parser, so only one may be alive at a time: Events() and
+    // Parse throw std::logic_error while another generator exists.
+    Generator<ParseEvent> Events(std::span<const std::string_view> args);
 
     StringArg& AddStringArgument(char, std::string, std::string = "");
     StringArg& AddStringArgument(std::string, std::string = "");
@@ -29,12 +58,52 @@ public:
     FlagArg& AddFlag(std::string, std::string = "");
     bool GetFlag(const std::string&, std::size_t = 0) const;
 
+    DoubleArg& AddDoubleArgument(char, std::string, std::string = "");
+    DoubleArg& AddDoubleArgument(std::string, std::string = "");
+    double GetDoubleValue(const std::string&, std::size_t = 0) const;
+
+    UnsignedArg& AddUnsignedArgument(char, std::string, std::string = "");
+    UnsignedArg& AddUnsignedArgument(std::string, std::string = "");
+    uint64_t GetUnsignedValue(const std::string&, std::size_t = 0) const;
+
+    DurationArg& AddDurationArgument(char, std::string, std::string = "");
+    DurationArg& AddDurationArgument(std::string, std::string = "");
+    std::chrono::nanoseconds GetDurationValue(const std::string&, std::size_t = 0) const;
+
+    ByteSizeArg& AddByteSizeArgument(char, std::string, std::string = "");
+    ByteSizeArg& AddByteSizeArgument(std::string, std::string = "");
+    uint64_t GetByteSizeValue(const std::string&, std::size_t = 0) const;
+
+    MapArg& AddMapArgument(char, std::string, std::string = "");
+    MapArg& AddMapArgument(std::string, std::string = "");
+    const FlatMap& GetMap(const std::string&) const;
+    std::optional<std::string_view> GetMapValue(const std::string&, std::string_view key) const;
+
     void AddHelp(char, std::string, std::string = "");
+    void AllowAbbreviations(bool = true);
+    void SetConversionThreads(std::size_t);
 
     bool Help() const;
     std::string HelpDescription() const;
+    const ParseError& Error() const;
+    // Tokens after a bare `--` in the last parse. They are views into the
+    // parsed input, which has to outlive their use.
+    std::span<const std::string_view> Passthrough() const;
+
+    std::vector<std::byte> SaveSnapshot() const;
+    bool LoadSnapshot(std::span<const std::byte>);
+    uint64_t SchemaFingerprint() const;
+
+    std::vector<std::byte> FreezeSchema() const;
 
 private:
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view str) const {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
     std::vector<std::unique_ptr<BaseArgument>> arguments_;
     using ArgPtr = std::unique_ptr<BaseArgument>;
     
@@ -43,24 +112,54 @@ private:
     std::unordered_map<std::string, char> short_names_;
     std::unordered_map<char, std::string> full_names_;
     std::unordered_map<std::string, std::string> descriptions_;
-    std::unordered_map<std::string, std::size_t> argument_indices_;
+    std::unordered_map<std::string, std::size_t, StringHash, std::equal_to<>> argument_indices_;
 
     std::string full_help_name_;
     std::string help_description_;
     char short_help_name_;
     bool has_help_;
 
-    std::string positional_argument_name_;
+    std::vector<std::pair<std::size_t, std::string_view>> positionals_;
+    bool positionals_built_ = false;
+    std::size_t positional_cursor_ = 0;
+    std::size_t positional_taken_ = 0;
+    std::vector<std::string_view> passthrough_;
+    bool events_active_ = false;
+
+    std::string command_line_;
+    std::vector<std::string_view> tokens_;
+    std::vector<ParseEvent> pending_events_;
+
+    // Events places its coroutine frame here through FrameBuffer::Scope.
+    FrameBuffer frame_buffer_;
+    SnapshotView snapshot_;
+    std::vector<std::byte> owned_schema_;
+    SchemaView schema_;
+
+    ParseError error_;
+    NameIndex name_index_;
+    bool allow_abbreviations_ = false;
+
+    static constexpr std::size_t kParallelThreshold = 1 << 15;
+    static constexpr std::size_t kParallelChunk = 1 << 13;
+    std::size_t conversion_threads_ = 0;
 
     inline static const std::unordered_map<ArgumentType, std::string> kTypeNames {
         {ArgumentType::kString, "string"},
         {ArgumentType::kInt, "int"},
         {ArgumentType::kFlag, "flag"},
+        {ArgumentType::kDouble, "double"},
+        {ArgumentType::kUnsigned, "unsigned"},
+        {ArgumentType::kDuration, "duration"},
+        {ArgumentType::kByteSize, "size"},
+        {ArgumentType::kMap, "key=value"},
     };
 
     struct ParseContext {
-        const std::vector<std::string>& args;
-        const std::string& full_name;
+        std::span<const std::string_view> args;
+        std::string_view full_name;
+        BaseArgument& argument;
+        std::size_t argument_index;
         std::size_t& index;
         std::size_t equal_pos;
         bool is_named;
@@ -76,43 +175,93 @@ private:
     void SetDescription(std::string& full_name, std::string& description);
     void SetArgument(char short_name, std::string& full_name, std::string& description);
     void CheckShortName(char short_name) const;
+    void CheckNotFrozen() const;
 
     template<typename T>
     T& AddArgument();
     
     template<typename T>
-    T& GetArgumentAs(const std::string& full_name, ArgumentType expected_type) const;
+    T GetValueAs(std::string_view full_name, ArgumentType expected_type, std::size_t index) const;
 
-    char GetShortName(const std::string& full_name) const;
-    ArgPtr& GetArgument(const std::string& full_name);
-    const ArgPtr& GetArgument(const std::string& full_name) const;
+    template<typename T>
+    static T ConvertDefault(std::string_view text);
+
+    std::size_t FindArgument(std::string_view full_name) const;
+    std::string_view FindShortArgument(char short_name) const;
+    std::vector<std::string_view> GetNames() const;
+    std::string_view GetDescription(std::string_view full_name) const;
+    ArgumentType GetArgumentType(std::size_t index) const;
+
+    std::size_t GetArgumentIndex(std::string_view full_name, ArgumentType expected_type) const;
+    char GetShortName(std::string_view full_name) const;
+    ArgPtr& GetArgument(std::string_view full_name);
+    ArgPtr& GetArgument(std::size_t index);
+
+    ArgPtr CreateArgument(std::size_t index) const;
+    ArgPtr CreateMapArgument(const SchemaView::Record& record) const;
+    template<typename T>
+    ArgPtr CreateArgument(const SchemaView::Record& record) const;
+
+    void AppendHelpLine(std::string& help_description, std::string_view full_name, 
+                        const BaseArgument& arg) const;
+
+    // Lives in the Events coroutine frame and marks the parser as busy for
+    // as long as that frame exists.
+    class EventsGuard {
+    public:
+        explicit EventsGuard(bool& active);
+        EventsGuard(EventsGuard&& other) noexcept;
+        ~EventsGuard();
+
+    private:
+        bool* active_;
+    };
+
+    bool ParseTokens(std::span<const std::string_view> args);
+    Generator<ParseEvent> RunEvents(std::span<const std::string_view> args, EventsGuard guard);
+    bool ApplyEvent(const ParseEvent& event);
+    void PushEvent(ParseEventKind kind, std::size_t index, std::string_view name, 
+                   std::string_view value = {}, std::span<const std::string_view> values = {});
+    void PushHelpEvent();
 
     bool ParseArgument(ParseContext&);
-    bool ParseTypeArgument(ParseContext&, bool = false);
+    bool ParseTypeArgument(ParseContext&);
     bool ParseMultivalue(ParseContext&);
-    bool ParseStringArgument(ParseContext&);
-    bool ParseIntArgument(ParseContext&);
+    bool ParseValueArgument(ParseContext&);
     bool ParseFlagArgument(ParseContext&);
     bool NextValueExists(ParseContext&) const;
+
+    bool StoreOptionValue(BaseArgument& argument, std::string_view full_name, std::string_view value);
+    template<typename T>
+    bool StoreValue(Argument<T>& argument, std::string_view full_name, std::string_view str);
+    bool StoreMapValue(MapArg& argument, std::string_view full_name, std::string_view pair);
+    bool CheckStringValue(const StringArg& argument, std::string_view full_name, std::string_view value);
     
-    bool ParseShortArgument(const std::vector<std::string>& args, size_t& i);
+    bool ParseShortArgument(std::span<const std::string_view> args, size_t& i);
     ValidationResult ValidateShortName(char short_name);
-    ValidationResult ValidateShortArgument(const std::string& arg);
-    bool ParseShortFlags(const std::string& args);
-    bool ParseFullArgument(const std::vector<std::string>& args, size_t& i);
-
-    bool ParsePositionalArgument(const std::vector<std::string>& args, size_t& i);
-    bool ParsePositionalStringArgument(ArgPtr& argument, const std::string& str);
-    bool ParsePositionalIntArgument(ArgPtr& argument, const std::string& str);
-    bool ParsePositionalFlagArgument();
+    ValidationResult ValidateShortArgument(std::string_view arg, std::size_t equal_pos);
+    bool ParseShortFlags(std::string_view args);
+    bool ParseFullArgument(std::span<const std::string_view> args, size_t& i);
+    ValidationResult ResolveAbbreviation(std::string_view& full_name, bool is_named);
 
-    bool IsNamedArgument(const std::string& arg) const;
-    bool SetPositionalArgument();
+    bool ParsePositionalArgument(std::span<const std::string_view> args, size_t& i);
+    bool IsStreamPositional();
+    void BuildPositionals();
+    bool ParsePositionalValue(ArgPtr& argument, std::string_view full_name, std::string_view value);
+    bool ParseValueRun(ArgPtr& argument, std::string_view full_name, std::span<const std::string_view> run);
+    template<typename T>
+    bool ParseConvertedRun(Argument<T>& argument, std::string_view full_name, std::span<const std::string_view> run);
+    template<typename T>
+    bool ParsePositionalValueArgument(ArgPtr& argument, std::string_view full_name, std::string_view str);
+    bool ParsePositionalFlagArgument(std::string_view full_name);
 
-    bool IsCorrectMultiValue() const;
-    bool AllHaveValues() const;
+    bool IsCorrectMultiValue();
+    bool AllHaveValues();
 
-    bool ConvertToNumber(const char* str, int64_t& number);
+    bool SetError(ParseErrorKind kind, std::string_view argument);
+    void ClearError();
+    void BuildNameIndex();
+    void SuggestNames(std::string_view full_name);
 };
 
 template<typename T>
@@ -124,10 +273,31 @@ T& ArgParser::AddArgument() {
 }
 
 template<typename T>
-T& ArgParser::GetArgumentAs(const std::string& full_name, ArgumentType expected_type) const {
-    const ArgPtr& arg = GetArgument(full_name);
-    if (arg->GetType() != expected_type)
-        throw std::invalid_argument(std::format("Argument is not of type {}", kTypeNames.at(expected_type)));
-    return dynamic_cast<T&>(*arg);
+T ArgParser::GetValueAs(std::string_view full_name, ArgumentType expected_type, std::size_t index) const {
+    std::size_t argument_index = GetArgumentIndex(full_name, expected_type);
+    if (arguments_[argument_index])
+        return dynamic_cast<const Argument<T>&>(*arguments_[argument_index]).GetValue(index);
+
+    SchemaView::Record record = schema_.GetRecord(argument_index);
+    if (record.flags & SchemaView::kMultiValue)
+        throw std::out_of_range("Index out of range for multi-value argument");
+    if (index > 0)
+        throw std::logic_error("Can only retrieve the first value of a single-value argument");
+    if (record.flags & SchemaView::kHasDefault)
+        return ConvertDefault<T>(schema_.GetString(record.default_value));
+    return T{};
+}
+
+template<typename T>
+T ArgParser::ConvertDefault(std::string_view text) {
+    T value{};
+    ConvertValue(text, value);
+    return value;
 }
-}
\ No newline at end of file
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "ArgParser/ArgParser-inl.hpp"
+#include "Schema/Schema-inl.hpp"
+#include "Snapshot/Snapshot-inl.hpp"
+#endif
@@ -0,0 +1,10 @@
+#pragma once
+
+// With ARGPARSER_HEADER_ONLY the definitions from the *-inl.hpp headers are
+// compiled into every user as inline functions (target argparser::header_only);
+// otherwise they are built once into the argparser library.
+#ifdef ARGPARSER_HEADER_ONLY
+#define ARGPARSER_INLINE inline
+#else
+#define ARGPARSER_INLINE
+#endif
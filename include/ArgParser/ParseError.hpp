@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ArgumentParser {
+enum class ParseErrorKind {
+    kNone,
+    kUnknownArgument,
+    kAmbiguousArgument,
+    kInvalidFormat,
+    kMissingValue,
+    kInvalidValue,
+    kNotEnoughValues,
+    kTooManyValues,
+    kMissingArgument,
+    kStreamError,
+    kDuplicateKey
+};
+
+struct ParseError {
+    ParseErrorKind kind = ParseErrorKind::kNone;
+    std::string argument;
+    std::vector<std::string> suggestions;
+    // Byte offset into the rejected value when a string policy fails.
+    std::size_t offset = 0;
+};
+}
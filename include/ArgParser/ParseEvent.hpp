@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include "Argument/Argument.hpp"
+
+namespace ArgumentParser {
+enum class ParseEventKind {
+    kOption,
+    kPositional,
+    kPassthrough,
+    kHelp,
+    kError
+};
+
+// One step of ArgParser::Events(). `index` is the registration index of the
+// argument. Options carry their raw text in `value` (empty for flags), or in
+// `values` for the space-separated run of a multi-value option; positional
+// arguments carry a run of raw values in `values`, and kPassthrough all
+// tokens after a bare `--`, which ends the stream. Views point into the
+// parsed tokens or the stream buffer and are valid until the next step.
+struct ParseEvent {
+    ParseEventKind kind;
+    std::string_view name{};
+    ArgumentType type{};
+    std::size_t index{};
+    std::string_view value{};
+    std::span<const std::string_view> values{};
+};
+}
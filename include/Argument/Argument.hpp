@@ -1,122 +1,273 @@
 #pragma once
 
+#include "Argument/Convert.hpp"
+#include "SmallVector/SmallVector.hpp"
+#include "Validation/Validation.hpp"
+
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 namespace ArgumentParser {
 enum class ArgumentType {
     kString,
     kInt,
-    kFlag
+    kFlag,
+    kDouble,
+    kUnsigned,
+    kDuration,
+    kByteSize,
+    kMap
 };
 
+template<typename T>
+constexpr ArgumentType ArgumentTypeOf() {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return ArgumentType::kString;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return ArgumentType::kInt;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return ArgumentType::kFlag;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return ArgumentType::kDouble;
+    } else if constexpr (std::is_same_v<T, uint64_t>) {
+        return ArgumentType::kUnsigned;
+    } else if constexpr (std::is_same_v<T, std::chrono::nanoseconds>) {
+        return ArgumentType::kDuration;
+    } else {
+        static_assert(std::is_same_v<T, ByteSize>, "Unsupported argument type");
+        return ArgumentType::kByteSize;
+    }
+}
+
+// Calls visitor(std::type_identity<T>{}) with the value type behind `type`.
+// Map arguments are not Argument<T> and have to be handled by the caller.
+template<typename Visitor>
+decltype(auto) VisitType(ArgumentType type, Visitor&& visitor) {
+    switch (type) {
+        case ArgumentType::kString:
+            return visitor(std::type_identity<std::string>{});
+        case ArgumentType::kInt:
+            return visitor(std::type_identity<int64_t>{});
+        case ArgumentType::kFlag:
+            return visitor(std::type_identity<bool>{});
+        case ArgumentType::kDouble:
+            return visitor(std::type_identity<double>{});
+        case ArgumentType::kUnsigned:
+            return visitor(std::type_identity<uint64_t>{});
+        case ArgumentType::kDuration:
+            return visitor(std::type_identity<std::chrono::nanoseconds>{});
+        case ArgumentType::kByteSize:
+            return visitor(std::type_identity<ByteSize>{});
+        case ArgumentType::kMap:
+            break;
+    }
+    throw std::logic_error("Unsupported argument type");
+}
+
 class BaseArgument {
 public:
+    static constexpr std::size_t kUnlimited = static_cast<std::size_t>(-1);
+
     virtual bool IsPositional() const = 0; 
     virtual bool IsMultiValue() const = 0;
     virtual bool HasDefault() const = 0;
     virtual std::string GetDefault() const = 0;
     virtual std::size_t min_args() const = 0;
+    virtual std::size_t max_args() const = 0;
     virtual ArgumentType GetType() const = 0;
     virtual std::size_t GetArgCount() const = 0;
     virtual bool has_value() const = 0;
+    virtual bool IsFromStream() const = 0;
+    virtual int GetStreamFd() const = 0;
+    virtual char GetStreamDelimiter() const = 0;
+    // Drops parsed values but keeps configuration and allocated capacity.
+    virtual void ClearValues() = 0;
+    // Writes the default into a bound variable that has no parsed value.
+    virtual void StoreDefault() = 0;
     virtual ~BaseArgument() = default;
 };
 
 template<typename T>
 class Argument : public BaseArgument {
 public:
-    Argument();
+    Argument() = default;
     Argument& Default(T);
     Argument& MultiValue(std::size_t = 0);
+    Argument& MultiValue(std::size_t min_args, std::size_t max_args);
     Argument& Positional();
     Argument& StoreValue(T&);
     Argument& StoreValues(std::vector<T>&);
+    Argument& FromStream(int fd = 0, char delimiter = '\n');
+    Argument& OnValue(std::function<void(const T&)>);
+    Argument& Validate(StringPolicy) requires std::is_same_v<T, std::string>;
 
     bool IsPositional() const override; 
     bool IsMultiValue() const override;
     bool has_value() const override;
     std::size_t min_args() const override;
+    std::size_t max_args() const override;
     std::size_t GetArgCount() const override;
     ArgumentType GetType() const override;
     bool HasDefault() const override;
     std::string GetDefault() const override;
+    bool IsFromStream() const override;
+    int GetStreamFd() const override;
+    char GetStreamDelimiter() const override;
+    void ClearValues() override;
+    void StoreDefault() override;
     T GetValue(std::size_t index) const;
+    std::size_t GetStoredCount() const;
+    const T& GetDefaultValue() const;
+    bool IsSet() const;
 
     void AddValue(T value);
+    void ReserveValues(std::size_t count);
+    // Appends `count` slots for the caller to overwrite. Internal storage
+    // leaves them uninitialized; a bound std::vector value-initializes them.
+    std::span<T> AppendValues(std::size_t count);
+    void ResizeValues(std::size_t size);
+    bool HasOnValue() const;
+    const StringPolicy* GetPolicy() const requires std::is_same_v<T, std::string>;
 
 private:
-    std::vector<T> values_;
-    std::vector<T>* stored_values_ = nullptr;
-    T* stored_value_ = nullptr;
-    std::size_t min_args_{};
-    T default_value_;
-    T value_{};
-    bool is_positional_{};
-    bool is_multivalue_{};
-    bool has_default_value_{};
-    bool has_value_{};
+    static constexpr std::size_t kInlineValues = std::max<std::size_t>(1, 16 / sizeof(T));
+
+    enum Flags : uint8_t {
+        kPositional = 1 << 0,
+        kMultiValue = 1 << 1,
+        kHasDefault = 1 << 2,
+        kHasValue = 1 << 3,
+        kFromStream = 1 << 4,
+        kStoresValue = 1 << 5,
+        kStoresValues = 1 << 6,
+        kValidated = 1 << 7
+    };
+
+    // Settings most arguments never use are kept out of line, so an argument
+    // without a default, callback or stream costs a single null pointer.
+    struct Extra {
+        T default_value{};
+        std::function<void(const T&)> on_value;
+        std::size_t delivered_count{};
+        int stream_fd{};
+        char stream_delimiter = '\n';
+        [[no_unique_address]] std::conditional_t<std::is_same_v<T, std::string>, StringPolicy, std::monostate> policy;
+    };
+
+    bool HasFlag(uint8_t flag) const;
+    Extra& GetExtra();
+    T* StoredValue() const;
+    std::vector<T>* StoredValues() const;
+
+    // Single-valued arguments keep their value in values_[0].
+    SmallVector<T, kInlineValues> values_;
+    void* store_ = nullptr;
+    std::unique_ptr<Extra> extra_;
+    uint32_t min_args_{};
+    uint32_t max_args_ = static_cast<uint32_t>(-1);
+    uint8_t flags_{};
 };
 
 using StringArg = Argument<std::string>;
 using FlagArg = Argument<bool>;
 using IntArg = Argument<int64_t>;
-
-template<typename T>
-Argument<T>::Argument() 
-        : stored_values_(nullptr), stored_value_(nullptr)
-        , min_args_(0)
-        , is_positional_(false), is_multivalue_(false)
-        , has_default_value_(false) {}
+using DoubleArg = Argument<double>;
+using UnsignedArg = Argument<uint64_t>;
+using DurationArg = Argument<std::chrono::nanoseconds>;
+using ByteSizeArg = Argument<ByteSize>;
 
 template<typename T>
 Argument<T>& Argument<T>::Default(T default_value) {
-    default_value_ = std::move(default_value);
-    has_default_value_ = true;
+    GetExtra().default_value = std::move(default_value);
+    flags_ |= kHasDefault;
     return *this;
 }
 template<typename T>
 Argument<T>& Argument<T>::MultiValue(std::size_t min_args) {
-    is_multivalue_ = true;
-    min_args_ = min_args;
+    flags_ |= kMultiValue;
+    min_args_ = static_cast<uint32_t>(min_args);
+    return *this;
+}
+
+template<typename T>
+Argument<T>& Argument<T>::MultiValue(std::size_t min_args, std::size_t max_args) {
+    if (max_args < min_args || max_args == 0) {
+        throw std::invalid_argument("MultiValue needs min_args <= max_args and max_args > 0");
+    }
+    MultiValue(min_args);
+    max_args_ = static_cast<uint32_t>(std::min<std::size_t>(max_args, static_cast<uint32_t>(-1)));
     return *this;
 }
 
 template<typename T>
 Argument<T>& Argument<T>::Positional() {
-    is_positional_ = true;
+    flags_ |= kPositional;
     return *this;
 }
 
 template<typename T>
 Argument<T>& Argument<T>::StoreValue(T& stored_value) {
-    stored_value_ = &stored_value;
+    store_ = &stored_value;
+    flags_ = (flags_ & ~kStoresValues) | kStoresValue;
     return *this;
 }
 
 template<typename T>
 Argument<T>& Argument<T>::StoreValues(std::vector<T>& stored_values) {
-    if (!is_multivalue_) {
+    if (!HasFlag(kMultiValue)) {
         throw std::logic_error("StoreValues can only be used with multi-value arguments");
     }
-    stored_values_ = &stored_values;
+    store_ = &stored_values;
+    flags_ = (flags_ & ~kStoresValue) | kStoresValues;
+    return *this;
+}
+
+template<typename T>
+Argument<T>& Argument<T>::FromStream(int fd, char delimiter) {
+    if (!HasFlag(kPositional) || !HasFlag(kMultiValue)) {
+        throw std::logic_error("FromStream can only be used with positional multi-value arguments");
+    }
+    flags_ |= kFromStream;
+    GetExtra().stream_fd = fd;
+    GetExtra().stream_delimiter = delimiter;
+    return *this;
+}
+
+template<typename T>
+Argument<T>& Argument<T>::OnValue(std::function<void(const T&)> on_value) {
+    GetExtra().on_value = std::move(on_value);
+    return *this;
+}
+
+template<typename T>
+Argument<T>& Argument<T>::Validate(StringPolicy policy) requires std::is_same_v<T, std::string> {
+    GetExtra().policy = policy;
+    flags_ |= kValidated;
     return *this;
 }
 
 template<typename T>
 bool Argument<T>::IsPositional() const {
-    return is_positional_;
+    return HasFlag(kPositional);
 }
 
 template<typename T>
 bool Argument<T>::IsMultiValue() const {
-    return is_multivalue_;
+    return HasFlag(kMultiValue);
 }
 
 template<typename T>
 bool Argument<T>::has_value() const {
-    return has_default_value_ || has_value_;
+    return HasFlag(kHasDefault) || HasFlag(kHasValue);
 }
 
 template<typename T>
@@ -124,50 +275,81 @@ std::size_t Argument<T>::min_args() const {
     return min_args_;
 }
 
+template<typename T>
+std::size_t Argument<T>::max_args() const {
+    return max_args_ == static_cast<uint32_t>(-1) ? kUnlimited : max_args_;
+}
+
 template<typename T>
 std::size_t Argument<T>::GetArgCount() const {
-    if (stored_values_)
-        return stored_values_->size();
+    if (HasOnValue())
+        return extra_->delivered_count;
+    if (std::vector<T>* stored_values = StoredValues())
+        return stored_values->size();
     return values_.size();
 }
 
 template<typename T>
 ArgumentType Argument<T>::GetType() const {
-    if constexpr (std::is_same_v<T, std::string>) {
-        return ArgumentType::kString;
-    } else if constexpr (std::is_same_v<T, int64_t>) {
-        return ArgumentType::kInt;
-    } else if constexpr (std::is_same_v<T, bool>) {
-        return ArgumentType::kFlag;
-    } else {
-        throw std::runtime_error("Unsupported argument type");
-    }
+    return ArgumentTypeOf<T>();
 }
 
 template<typename T>
 bool Argument<T>::HasDefault() const {
-    return has_default_value_;
+    return HasFlag(kHasDefault);
 }
 
 template<typename T>
 std::string Argument<T>::GetDefault() const {
-    if (has_default_value_) {
-        if constexpr (std::is_same_v<T, std::string>) {
-            return default_value_;
-        } else {
-            return std::to_string(default_value_);
-        }
-    }
+    if (HasFlag(kHasDefault))
+        return FormatValue(extra_->default_value);
     return {};
 }
 
+template<typename T>
+bool Argument<T>::IsFromStream() const {
+    return HasFlag(kFromStream);
+}
+
+template<typename T>
+int Argument<T>::GetStreamFd() const {
+    return extra_ ? extra_->stream_fd : 0;
+}
+
+template<typename T>
+char Argument<T>::GetStreamDelimiter() const {
+    return extra_ ? extra_->stream_delimiter : '\n';
+}
+
+// A single value stays in values_[0] so the next parse can reuse it; values
+// bound with StoreValue are left to StoreDefault at the next parse.
+template<typename T>
+void Argument<T>::ClearValues() {
+    flags_ &= ~kHasValue;
+    if (extra_)
+        extra_->delivered_count = 0;
+    if (!HasFlag(kMultiValue))
+        return;
+    if (std::vector<T>* stored_values = StoredValues())
+        stored_values->clear();
+    values_.clear();
+}
+
+template<typename T>
+void Argument<T>::StoreDefault() {
+    if (HasFlag(kMultiValue) || !HasFlag(kHasDefault) || HasFlag(kHasValue))
+        return;
+    if (T* stored_value = StoredValue())
+        *stored_value = extra_->default_value;
+}
+
 template<typename T>
 T Argument<T>::GetValue(std::size_t index) const {
-    if (is_multivalue_) {
-        if (stored_values_) {
-            if (index >= stored_values_->size())
+    if (HasFlag(kMultiValue)) {
+        if (std::vector<T>* stored_values = StoredValues()) {
+            if (index >= stored_values->size())
                 throw std::out_of_range("Index out of range for multi-value argument");
-            return (*stored_values_)[index];
+            return (*stored_values)[index];
         }
         if (index >= values_.size())
             throw std::out_of_range("Index out of range for multi-value argument");
@@ -176,29 +358,124 @@ T Argument<T>::GetValue(std::size_t index) const {
     if (index > 0)
         throw std::logic_error("Can only retrieve the first value of a single-value argument");
 
-    if (stored_value_)
-        return *stored_value_;
-    if (has_default_value_ && !has_value_)
-        return default_value_;
-    return value_;
+    if (HasFlag(kHasDefault) && !HasFlag(kHasValue))
+        return extra_->default_value;
+    if (T* stored_value = StoredValue())
+        return *stored_value;
+    return values_.empty() || !HasFlag(kHasValue) ? T{} : values_[0];
+}
+
+template<typename T>
+std::size_t Argument<T>::GetStoredCount() const {
+    if (HasFlag(kMultiValue)) {
+        std::vector<T>* stored_values = StoredValues();
+        return stored_values ? stored_values->size() : values_.size();
+    }
+    return HasFlag(kHasValue) && !HasOnValue() ? 1 : 0;
+}
+
+template<typename T>
+const T& Argument<T>::GetDefaultValue() const {
+    static const T kEmpty{};
+    return extra_ ? extra_->default_value : kEmpty;
+}
+
+template<typename T>
+bool Argument<T>::IsSet() const {
+    return HasFlag(kHasValue);
+}
+
+template<typename T>
+void Argument<T>::ReserveValues(std::size_t count) {
+    if (std::vector<T>* stored_values = StoredValues()) {
+        stored_values->reserve(stored_values->size() + count);
+        return;
+    }
+    values_.reserve(values_.size() + count);
+}
+
+template<typename T>
+std::span<T> Argument<T>::AppendValues(std::size_t count) {
+    if (!HasFlag(kMultiValue) || HasOnValue()) {
+        throw std::logic_error("AppendValues can only be used with stored multi-value arguments");
+    }
+    flags_ |= kHasValue;
+    if (std::vector<T>* stored_values = StoredValues()) {
+        std::size_t size = stored_values->size();
+        stored_values->resize(size + count);
+        return std::span<T>(*stored_values).subspan(size);
+    }
+    std::size_t size = values_.size();
+    values_.resize_for_overwrite(size + count);
+    return std::span<T>(values_.data() + size, count);
+}
+
+template<typename T>
+void Argument<T>::ResizeValues(std::size_t size) {
+    if (std::vector<T>* stored_values = StoredValues()) {
+        stored_values->resize(size);
+        return;
+    }
+    values_.resize(size);
+}
+
+template<typename T>
+bool Argument<T>::HasOnValue() const {
+    return extra_ && extra_->on_value;
+}
+
+template<typename T>
+const StringPolicy* Argument<T>::GetPolicy() const requires std::is_same_v<T, std::string> {
+    return HasFlag(kValidated) ? &extra_->policy : nullptr;
 }
 
 template<typename T>
 void Argument<T>::AddValue(T value) {
-    has_value_ = true;
-    if (is_multivalue_) {
-        if (stored_values_) {
-            stored_values_->push_back(std::move(value));
+    flags_ |= kHasValue;
+    if (HasOnValue()) {
+        extra_->on_value(value);
+        ++extra_->delivered_count;
+        return;
+    }
+    if (HasFlag(kMultiValue)) {
+        if (std::vector<T>* stored_values = StoredValues()) {
+            stored_values->push_back(std::move(value));
             return;
         }
         values_.push_back(std::move(value));
         return;
     }
-    if (stored_value_) {
-        *stored_value_ = std::move(value);
+    if (T* stored_value = StoredValue()) {
+        *stored_value = std::move(value);
         return;
     }
-    value_ = std::move(value);
+    if (values_.empty()) {
+        values_.push_back(std::move(value));
+        return;
+    }
+    values_[0] = std::move(value);
+}
+
+template<typename T>
+bool Argument<T>::HasFlag(uint8_t flag) const {
+    return flags_ & flag;
+}
+
+template<typename T>
+auto Argument<T>::GetExtra() -> Extra& {
+    if (!extra_)
+        extra_ = std::make_unique<Extra>();
+    return *extra_;
+}
+
+template<typename T>
+T* Argument<T>::StoredValue() const {
+    return HasFlag(kStoresValue) ? static_cast<T*>(store_) : nullptr;
+}
+
+template<typename T>
+std::vector<T>* Argument<T>::StoredValues() const {
+    return HasFlag(kStoresValues) ? static_cast<std::vector<T>*>(store_) : nullptr;
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,256 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "Argument/Convert.hpp"
+#endif
+
+#include <charconv>
+#include <limits>
+
+namespace ArgumentParser {
+namespace detail {
+struct Unit {
+    std::string_view suffix;
+    uint64_t scale;
+};
+
+inline constexpr Unit kDurationUnits[] = {
+    {"ns", 1},
+    {"us", 1'000},
+    {"ms", 1'000'000},
+    {"s", 1'000'000'000},
+    {"m", 60'000'000'000},
+    {"min", 60'000'000'000},
+    {"h", 3'600'000'000'000},
+    {"d", 86'400'000'000'000},
+};
+
+inline constexpr Unit kByteUnits[] = {
+    {"", 1},
+    {"B", 1},
+    {"K", 1ULL << 10}, {"k", 1ULL << 10}, {"KiB", 1ULL << 10},
+    {"M", 1ULL << 20}, {"MiB", 1ULL << 20},
+    {"G", 1ULL << 30}, {"GiB", 1ULL << 30},
+    {"T", 1ULL << 40}, {"TiB", 1ULL << 40},
+    {"P", 1ULL << 50}, {"PiB", 1ULL << 50},
+    {"E", 1ULL << 60}, {"EiB", 1ULL << 60},
+    {"kB", 1'000ULL}, {"KB", 1'000ULL},
+    {"MB", 1'000'000ULL},
+    {"GB", 1'000'000'000ULL},
+    {"TB", 1'000'000'000'000ULL},
+    {"PB", 1'000'000'000'000'000ULL},
+    {"EB", 1'000'000'000'000'000'000ULL},
+};
+
+inline constexpr std::size_t kMaxFractionDigits = 9;
+
+ARGPARSER_INLINE bool IsDigit(char symbol) {
+    return symbol >= '0' && symbol <= '9';
+}
+
+// 0x/0X and 0b/0B followed by at least one digit.
+ARGPARSER_INLINE bool HasRadixPrefix(std::string_view str) {
+    return str.size() > 2 && str[0] == '0' 
+           && (str[1] == 'x' || str[1] == 'X' || str[1] == 'b' || str[1] == 'B');
+}
+
+ARGPARSER_INLINE bool ParseUnsigned(std::string_view str, uint64_t& value) {
+    int base = 10;
+    if (HasRadixPrefix(str)) {
+        base = str[1] == 'x' || str[1] == 'X' ? 16 : 2;
+        str.remove_prefix(2);
+    }
+    if (str.empty() || str[0] == '+' || str[0] == '-')
+        return false;
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value, base);
+    return ec == std::errc{} && ptr == str.data() + str.size();
+}
+
+ARGPARSER_INLINE bool MultiplyAdd(uint64_t& total, uint64_t value, uint64_t scale) {
+    if (value != 0 && scale > std::numeric_limits<uint64_t>::max() / value)
+        return false;
+    uint64_t product = value * scale;
+    if (product > std::numeric_limits<uint64_t>::max() - total)
+        return false;
+    total += product;
+    return true;
+}
+
+// Parses "<digits>[.<digits>]<unit>" from the front of `str` and adds the
+// scaled amount to `total`. The fraction is applied exactly as
+// fraction * scale / 10^digits, so "1.5KiB" is 1536 bytes.
+template<std::size_t N>
+bool ParseScaledComponent(std::string_view& str, const Unit (&units)[N], uint64_t& total) {
+    std::size_t pos = 0;
+    while (pos < str.size() && IsDigit(str[pos]))
+        ++pos;
+    uint64_t whole = 0;
+    if (pos > 0 && !ParseUnsigned(str.substr(0, pos), whole))
+        return false;
+
+    uint64_t fraction = 0;
+    uint64_t fraction_scale = 1;
+    bool has_fraction = pos < str.size() && str[pos] == '.';
+    if (has_fraction) {
+        ++pos;
+        std::size_t digits = 0;
+        for (; pos < str.size() && IsDigit(str[pos]); ++pos, ++digits) {
+            if (digits < kMaxFractionDigits) {
+                fraction = fraction * 10 + (str[pos] - '0');
+                fraction_scale *= 10;
+            }
+        }
+        if (digits == 0)
+            return false;
+    } else if (pos == 0) {
+        return false;
+    }
+
+    std::size_t unit_end = pos;
+    while (unit_end < str.size() && !IsDigit(str[unit_end]) && str[unit_end] != '.')
+        ++unit_end;
+    std::string_view suffix = str.substr(pos, unit_end - pos);
+    for (const Unit& unit : units) {
+        if (unit.suffix != suffix)
+            continue;
+        uint64_t fraction_part = fraction * (unit.scale / fraction_scale)
+                               + fraction * (unit.scale % fraction_scale) / fraction_scale;
+        if (!MultiplyAdd(total, whole, unit.scale) || !MultiplyAdd(total, fraction_part, 1))
+            return false;
+        str.remove_prefix(unit_end);
+        return true;
+    }
+    return false;
+}
+
+template<typename T>
+std::string FormatInteger(T value) {
+    char buffer[24];
+    auto [ptr, _] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, ptr);
+}
+}
+
+ARGPARSER_INLINE bool ConvertValue(std::string_view str, std::string& value) {
+    value.assign(str);
+    return true;
+}
+
+ARGPARSER_INLINE bool ConvertValue(std::string_view str, bool& value) {
+    if (str == "1" || str == "true") {
+        value = true;
+        return true;
+    }
+    if (str == "0" || str == "false") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+ARGPARSER_INLINE bool ConvertValue(std::string_view str, int64_t& value) {
+    bool negative = str.starts_with('-');
+    if (negative)
+        str.remove_prefix(1);
+    uint64_t magnitude;
+    if (!detail::ParseUnsigned(str, magnitude))
+        return false;
+
+    constexpr uint64_t kMax = std::numeric_limits<int64_t>::max();
+    if (magnitude > kMax + (negative ? 1 : 0))
+        return false;
+    value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+ARGPARSER_INLINE bool ConvertValue(std::string_view str, uint64_t& value) {
+    return detail::ParseUnsigned(str, value);
+}
+
+ARGPARSER_INLINE bool ConvertValue(std::string_view str, double& value) {
+    if (str.starts_with('+'))
+        return false;
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    return ec == std::errc{} && ptr == str.data() + str.size();
+}
+
+ARGPARSER_INLINE bool ConvertValue(std::string_view str, std::chrono::nanoseconds& value) {
+    bool negative = str.starts_with('-');
+    if (negative)
+        str.remove_prefix(1);
+    if (str == "0") {
+        value = std::chrono::nanoseconds::zero();
+        return true;
+    }
+    if (str.empty())
+        return false;
+
+    uint64_t total = 0;
+    while (!str.empty()) {
+        if (!detail::ParseScaledComponent(str, detail::kDurationUnits, total))
+            return false;
+    }
+    constexpr uint64_t kMax = std::numeric_limits<int64_t>::max();
+    if (total > kMax + (negative ? 1 : 0))
+        return false;
+    value = std::chrono::nanoseconds(negative ? static_cast<int64_t>(0 - total) : static_cast<int64_t>(total));
+    return true;
+}
+
+ARGPARSER_INLINE bool ConvertValue(std::string_view str, ByteSize& value) {
+    if (detail::HasRadixPrefix(str))
+        return detail::ParseUnsigned(str, value.bytes);
+
+    uint64_t total = 0;
+    if (!detail::ParseScaledComponent(str, detail::kByteUnits, total) || !str.empty())
+        return false;
+    value.bytes = total;
+    return true;
+}
+
+ARGPARSER_INLINE std::string FormatValue(const std::string& value) {
+    return value;
+}
+
+ARGPARSER_INLINE std::string FormatValue(bool value) {
+    return value ? "1" : "0";
+}
+
+ARGPARSER_INLINE std::string FormatValue(int64_t value) {
+    return detail::FormatInteger(value);
+}
+
+ARGPARSER_INLINE std::string FormatValue(uint64_t value) {
+    return detail::FormatInteger(value);
+}
+
+ARGPARSER_INLINE std::string FormatValue(double value) {
+    char buffer[32];
+    auto [ptr, _] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, ptr);
+}
+
+ARGPARSER_INLINE std::string FormatValue(std::chrono::nanoseconds value) {
+    int64_t count = value.count();
+    if (count == 0)
+        return "0s";
+    std::string sign = count < 0 ? "-" : "";
+    uint64_t magnitude = count < 0 ? 0 - static_cast<uint64_t>(count) : static_cast<uint64_t>(count);
+    for (std::size_t i = std::size(detail::kDurationUnits); i-- > 0;) {
+        const detail::Unit& unit = detail::kDurationUnits[i];
+        if (unit.suffix != "min" && magnitude % unit.scale == 0)
+            return sign + detail::FormatInteger(magnitude / unit.scale) + std::string(unit.suffix);
+    }
+    return sign + detail::FormatInteger(magnitude) + "ns";
+}
+
+ARGPARSER_INLINE std::string FormatValue(ByteSize value) {
+    constexpr std::string_view kSuffixes[] = {"EiB", "PiB", "TiB", "GiB", "MiB", "KiB"};
+    for (std::size_t i = 0; i < std::size(kSuffixes); ++i) {
+        uint64_t scale = 1ULL << (10 * (std::size(kSuffixes) - i));
+        if (value.bytes != 0 && value.bytes % scale == 0)
+            return detail::FormatInteger(value.bytes / scale) + std::string(kSuffixes[i]);
+    }
+    return detail::FormatInteger(value.bytes) + "B";
+}
+}
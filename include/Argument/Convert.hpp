@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "ArgParser/Config.hpp"
+
+namespace ArgumentParser {
+struct ByteSize {
+    uint64_t bytes{};
+
+    auto operator<=>(const ByteSize&) const = default;
+};
+
+// Converters used for every value that comes from the command line. Each one
+// consumes the whole string and fails on trailing characters or overflow.
+// Integers accept 0x/0b prefixes, durations a sequence of <number><unit>
+// (ns, us, ms, s, m, min, h, d; "1h30m", "1.5s") and byte sizes an optional
+// IEC (K, KiB, ...) or SI (kB, KB, MB, ...) suffix.
+bool ConvertValue(std::string_view str, std::string& value);
+bool ConvertValue(std::string_view str, bool& value);
+bool ConvertValue(std::string_view str, int64_t& value);
+bool ConvertValue(std::string_view str, uint64_t& value);
+bool ConvertValue(std::string_view str, double& value);
+bool ConvertValue(std::string_view str, std::chrono::nanoseconds& value);
+bool ConvertValue(std::string_view str, ByteSize& value);
+
+// Inverse of ConvertValue, used for help output and frozen schema defaults.
+std::string FormatValue(const std::string& value);
+std::string FormatValue(bool value);
+std::string FormatValue(int64_t value);
+std::string FormatValue(uint64_t value);
+std::string FormatValue(double value);
+std::string FormatValue(std::chrono::nanoseconds value);
+std::string FormatValue(ByteSize value);
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "Argument/Convert-inl.hpp"
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "Argument/MapArgument.hpp"
+#endif
+
+namespace ArgumentParser {
+ARGPARSER_INLINE MapArg& MapArg::OnDuplicate(DuplicatePolicy policy) {
+    duplicate_policy_ = policy;
+    return *this;
+}
+
+ARGPARSER_INLINE MapArg& MapArg::StoreValues(FlatMap& stored_values) {
+    stored_values_ = &stored_values;
+    return *this;
+}
+
+ARGPARSER_INLINE bool MapArg::IsPositional() const {
+    return false;
+}
+
+ARGPARSER_INLINE bool MapArg::IsMultiValue() const {
+    return false;
+}
+
+ARGPARSER_INLINE bool MapArg::has_value() const {
+    return true;
+}
+
+ARGPARSER_INLINE std::size_t MapArg::min_args() const {
+    return 0;
+}
+
+ARGPARSER_INLINE std::size_t MapArg::max_args() const {
+    return kUnlimited;
+}
+
+ARGPARSER_INLINE std::size_t MapArg::GetArgCount() const {
+    return GetValues().Size();
+}
+
+ARGPARSER_INLINE ArgumentType MapArg::GetType() const {
+    return ArgumentType::kMap;
+}
+
+ARGPARSER_INLINE bool MapArg::HasDefault() const {
+    return false;
+}
+
+ARGPARSER_INLINE std::string MapArg::GetDefault() const {
+    return {};
+}
+
+ARGPARSER_INLINE bool MapArg::IsFromStream() const {
+    return false;
+}
+
+ARGPARSER_INLINE int MapArg::GetStreamFd() const {
+    return 0;
+}
+
+ARGPARSER_INLINE char MapArg::GetStreamDelimiter() const {
+    return '\n';
+}
+
+ARGPARSER_INLINE DuplicatePolicy MapArg::GetDuplicatePolicy() const {
+    return duplicate_policy_;
+}
+
+ARGPARSER_INLINE const FlatMap& MapArg::GetValues() const {
+    return stored_values_ ? *stored_values_ : values_;
+}
+
+ARGPARSER_INLINE bool MapArg::IsSet() const {
+    return has_value_;
+}
+
+ARGPARSER_INLINE bool MapArg::AddPair(std::string_view key, std::string_view value) {
+    has_value_ = true;
+    switch (duplicate_policy_) {
+        case DuplicatePolicy::kLastWins:
+            Values().InsertOrAssign(key, value);
+            return true;
+        case DuplicatePolicy::kFirstWins:
+            Values().Insert(key, value);
+            return true;
+        case DuplicatePolicy::kError:
+            return Values().Insert(key, value);
+    }
+    return true;
+}
+
+ARGPARSER_INLINE void MapArg::ClearValues() {
+    Values().Clear();
+    has_value_ = false;
+}
+
+ARGPARSER_INLINE void MapArg::StoreDefault() {}
+
+ARGPARSER_INLINE FlatMap& MapArg::Values() {
+    return stored_values_ ? *stored_values_ : values_;
+}
+}
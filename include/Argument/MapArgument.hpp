@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "ArgParser/Config.hpp"
+#include "Argument/Argument.hpp"
+#include "FlatMap/FlatMap.hpp"
+
+namespace ArgumentParser {
+enum class DuplicatePolicy : uint8_t {
+    kLastWins,
+    kFirstWins,
+    kError
+};
+
+// Repeatable `--name key=value` argument. Every occurrence is split at the
+// first '=' while parsing and stored in a FlatMap.
+class MapArg : public BaseArgument {
+public:
+    MapArg& OnDuplicate(DuplicatePolicy);
+    MapArg& StoreValues(FlatMap&);
+
+    bool IsPositional() const override;
+    bool IsMultiValue() const override;
+    bool has_value() const override;
+    std::size_t min_args() const override;
+    std::size_t max_args() const override;
+    std::size_t GetArgCount() const override;
+    ArgumentType GetType() const override;
+    bool HasDefault() const override;
+    std::string GetDefault() const override;
+    bool IsFromStream() const override;
+    int GetStreamFd() const override;
+    char GetStreamDelimiter() const override;
+    void ClearValues() override;
+    void StoreDefault() override;
+
+    DuplicatePolicy GetDuplicatePolicy() const;
+    const FlatMap& GetValues() const;
+    bool IsSet() const;
+
+    // Returns false only when the key is already present and the policy is
+    // DuplicatePolicy::kError.
+    bool AddPair(std::string_view key, std::string_view value);
+
+private:
+    FlatMap& Values();
+
+    FlatMap values_;
+    FlatMap* stored_values_ = nullptr;
+    DuplicatePolicy duplicate_policy_ = DuplicatePolicy::kLastWins;
+    bool has_value_{};
+};
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "Argument/MapArgument-inl.hpp"
+#endif
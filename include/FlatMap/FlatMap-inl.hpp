@@ -0,0 +1,160 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "FlatMap/FlatMap.hpp"
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace ArgumentParser {
+namespace detail {
+inline constexpr std::size_t kMinTableSize = 16;
+}
+
+ARGPARSER_INLINE bool FlatMap::Insert(std::string_view key, std::string_view value) {
+    return Emplace(key, value, false);
+}
+
+ARGPARSER_INLINE bool FlatMap::InsertOrAssign(std::string_view key, std::string_view value) {
+    return Emplace(key, value, true);
+}
+
+ARGPARSER_INLINE std::optional<std::string_view> FlatMap::Find(std::string_view key) const {
+    if (entries_.empty())
+        return std::nullopt;
+    uint32_t index = table_[FindSlot(key, std::hash<std::string_view>{}(key))];
+    if (index == 0)
+        return std::nullopt;
+    const Entry& entry = entries_[index - 1];
+    return std::string_view(pool_).substr(entry.value_offset, entry.value_length);
+}
+
+ARGPARSER_INLINE bool FlatMap::Contains(std::string_view key) const {
+    return Find(key).has_value();
+}
+
+ARGPARSER_INLINE auto FlatMap::GetEntry(std::size_t index) const -> value_type {
+    const Entry& entry = entries_[index];
+    std::string_view pool = pool_;
+    return {pool.substr(entry.key_offset, entry.key_length), pool.substr(entry.value_offset, entry.value_length)};
+}
+
+ARGPARSER_INLINE std::size_t FlatMap::Size() const {
+    return entries_.size();
+}
+
+ARGPARSER_INLINE bool FlatMap::Empty() const {
+    return entries_.empty();
+}
+
+ARGPARSER_INLINE void FlatMap::Reserve(std::size_t count) {
+    entries_.reserve(count);
+    std::size_t table_size = std::bit_ceil(std::max(detail::kMinTableSize, 2 * count));
+    if (table_size > table_.size())
+        Rehash(table_size);
+}
+
+ARGPARSER_INLINE void FlatMap::Clear() {
+    pool_.clear();
+    dead_bytes_ = 0;
+    entries_.clear();
+    std::fill(table_.begin(), table_.end(), 0);
+}
+
+ARGPARSER_INLINE auto FlatMap::begin() const -> Iterator {
+    return Iterator(this, 0);
+}
+
+ARGPARSER_INLINE auto FlatMap::end() const -> Iterator {
+    return Iterator(this, entries_.size());
+}
+
+ARGPARSER_INLINE bool FlatMap::Emplace(std::string_view key, std::string_view value, bool assign) {
+    if (2 * (entries_.size() + 1) > table_.size())
+        Rehash(std::max(detail::kMinTableSize, 2 * table_.size()));
+
+    uint64_t hash = std::hash<std::string_view>{}(key);
+    std::size_t slot = FindSlot(key, hash);
+    if (uint32_t index = table_[slot]) {
+        if (assign)
+            Assign(entries_[index - 1], value);
+        return false;
+    }
+
+    if (entries_.size() >= std::numeric_limits<uint32_t>::max())
+        throw std::length_error("FlatMap exceeds 2^32 entries");
+    Entry entry{hash, AppendToPool(key), static_cast<uint32_t>(key.size()), 0, 0};
+    entry.value_offset = AppendToPool(value);
+    entry.value_length = static_cast<uint32_t>(value.size());
+    entries_.push_back(entry);
+    table_[slot] = static_cast<uint32_t>(entries_.size());
+    return true;
+}
+
+ARGPARSER_INLINE std::size_t FlatMap::FindSlot(std::string_view key, uint64_t hash) const {
+    std::size_t mask = table_.size() - 1;
+    std::size_t slot = hash & mask;
+    std::string_view pool = pool_;
+    while (uint32_t index = table_[slot]) {
+        const Entry& entry = entries_[index - 1];
+        if (entry.hash == hash && pool.substr(entry.key_offset, entry.key_length) == key)
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+ARGPARSER_INLINE uint32_t FlatMap::AppendToPool(std::string_view str) {
+    if (str.size() > std::numeric_limits<uint32_t>::max() - pool_.size())
+        throw std::length_error("FlatMap pool exceeds 4 GiB");
+    uint32_t offset = static_cast<uint32_t>(pool_.size());
+    pool_.append(str);
+    return offset;
+}
+
+ARGPARSER_INLINE void FlatMap::Assign(Entry& entry, std::string_view value) {
+    if (value.size() <= entry.value_length) {
+        // `value` may point into the pool itself, hence move rather than copy.
+        std::char_traits<char>::move(pool_.data() + entry.value_offset, value.data(), value.size());
+        dead_bytes_ += entry.value_length - value.size();
+        entry.value_length = static_cast<uint32_t>(value.size());
+        return;
+    }
+    dead_bytes_ += entry.value_length;
+    entry.value_offset = AppendToPool(value);
+    entry.value_length = static_cast<uint32_t>(value.size());
+    if (2 * dead_bytes_ > pool_.size())
+        CompactPool();
+}
+
+ARGPARSER_INLINE void FlatMap::CompactPool() {
+    std::string pool;
+    pool.reserve(pool_.size() - dead_bytes_);
+    for (Entry& entry : entries_) {
+        uint32_t key_offset = static_cast<uint32_t>(pool.size());
+        pool.append(pool_, entry.key_offset, entry.key_length);
+        uint32_t value_offset = static_cast<uint32_t>(pool.size());
+        pool.append(pool_, entry.value_offset, entry.value_length);
+        entry.key_offset = key_offset;
+        entry.value_offset = value_offset;
+    }
+    pool_ = std::move(pool);
+    dead_bytes_ = 0;
+}
+
+ARGPARSER_INLINE void FlatMap::Rehash(std::size_t table_size) {
+    table_.assign(table_size, 0);
+    std::size_t mask = table_size - 1;
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        std::size_t slot = entries_[i].hash & mask;
+        while (table_[slot] != 0)
+            slot = (slot + 1) & mask;
+        table_[slot] = static_cast<uint32_t>(i + 1);
+    }
+}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "ArgParser/Config.hpp"
+
+namespace ArgumentParser {
+// Open-addressing string map used by key=value arguments. Keys and values are
+// copied into one pooled buffer and referenced by offset, entries keep their
+// insertion order, and the probe table holds only 4-byte entry indices, so a
+// lookup costs one hash, a short linear probe and a single key comparison.
+// Views returned by Find and iteration stay valid until the next insertion;
+// InsertOrAssign overwrites a value in place when the new one fits and
+// compacts the pool once more than half of it is dead.
+class FlatMap {
+public:
+    using value_type = std::pair<std::string_view, std::string_view>;
+
+    class Iterator {
+    public:
+        Iterator(const FlatMap* map, std::size_t index) : map_(map), index_(index) {}
+        value_type operator*() const { return map_->GetEntry(index_); }
+        Iterator& operator++() { ++index_; return *this; }
+        bool operator==(const Iterator&) const = default;
+
+    private:
+        const FlatMap* map_;
+        std::size_t index_;
+    };
+
+    // Both return true if the key was not present. Insert keeps an existing
+    // value, InsertOrAssign replaces it.
+    bool Insert(std::string_view key, std::string_view value);
+    bool InsertOrAssign(std::string_view key, std::string_view value);
+
+    std::optional<std::string_view> Find(std::string_view key) const;
+    bool Contains(std::string_view key) const;
+    value_type GetEntry(std::size_t index) const;
+
+    std::size_t Size() const;
+    bool Empty() const;
+    void Reserve(std::size_t count);
+    void Clear();
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    struct Entry {
+        uint64_t hash;
+        uint32_t key_offset;
+        uint32_t key_length;
+        uint32_t value_offset;
+        uint32_t value_length;
+    };
+
+    bool Emplace(std::string_view key, std::string_view value, bool assign);
+    std::size_t FindSlot(std::string_view key, uint64_t hash) const;
+    uint32_t AppendToPool(std::string_view str);
+    void Assign(Entry& entry, std::string_view value);
+    void CompactPool();
+    void Rehash(std::size_t table_size);
+
+    std::string pool_;
+    std::size_t dead_bytes_ = 0;
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> table_;
+};
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "FlatMap/FlatMap-inl.hpp"
+#endif
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace ArgumentParser {
+// Storage for one coroutine frame that is kept between coroutines and only
+// grows, owned by the object whose coroutine it serves. While a frame is
+// live the buffer is taken and further frames go to the heap. Copies start
+// empty so that two owners never share a block.
+class FrameBuffer {
+public:
+    // While alive, the next Generator frame allocated on this thread is
+    // placed in `buffer`. Open it right before calling the coroutine.
+    class Scope {
+    public:
+        explicit Scope(FrameBuffer& buffer) noexcept : previous_(std::exchange(pending_, &buffer)) {}
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope() { pending_ = previous_; }
+
+    private:
+        FrameBuffer* previous_;
+    };
+
+    FrameBuffer() = default;
+    FrameBuffer(const FrameBuffer&) noexcept {}
+    FrameBuffer& operator=(const FrameBuffer&) noexcept { return *this; }
+    ~FrameBuffer() { ::operator delete(block_); }
+
+    void* Acquire(std::size_t size) {
+        if (in_use_)
+            return nullptr;
+        if (capacity_ < size) {
+            void* block = ::operator new(size);
+            ::operator delete(block_);
+            block_ = block;
+            capacity_ = size;
+        }
+        in_use_ = true;
+        return block_;
+    }
+    void Release() noexcept { in_use_ = false; }
+    static FrameBuffer* TakePending() noexcept { return std::exchange(pending_, nullptr); }
+
+private:
+    static inline thread_local FrameBuffer* pending_ = nullptr;
+
+    void* block_ = nullptr;
+    std::size_t capacity_ = 0;
+    bool in_use_ = false;
+};
+
+// Minimal lazily evaluated coroutine range in the spirit of std::generator.
+// Yielded values are observed by reference and stay valid until the
+// coroutine is resumed. Only single-pass input iteration is supported.
+template<typename T>
+class Generator {
+public:
+    struct promise_type {
+        const T* value = nullptr;
+        std::exception_ptr exception;
+
+        Generator get_return_object() {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& yielded) noexcept {
+            value = std::addressof(yielded);
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        template<typename U>
+        std::suspend_never await_transform(U&&) = delete;
+
+        // Coroutines called inside a FrameBuffer::Scope place their frame in
+        // that buffer, so an object that runs the same coroutine repeatedly
+        // allocates once. The buffer is not passed as an argument: a
+        // placement form would have no operator delete to pair with.
+        static void* operator new(std::size_t size) {
+            if (FrameBuffer* buffer = FrameBuffer::TakePending())
+                if (void* block = buffer->Acquire(kFrameHeader + size))
+                    return WithHeader(block, buffer);
+            return WithHeader(::operator new(kFrameHeader + size), nullptr);
+        }
+        static void operator delete(void* ptr) {
+            void* block = static_cast<std::byte*>(ptr) - kFrameHeader;
+            if (FrameBuffer* buffer = *static_cast<FrameBuffer**>(block))
+                buffer->Release();
+            else
+                ::operator delete(block);
+        }
+    };
+
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        Iterator() = default;
+        explicit Iterator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+        const T& operator*() const { return *handle_.promise().value; }
+        const T* operator->() const { return handle_.promise().value; }
+        Iterator& operator++() {
+            Resume(handle_);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return !handle_ || handle_.done(); }
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    Generator(Generator&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (handle_)
+                handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    ~Generator() {
+        if (handle_)
+            handle_.destroy();
+    }
+
+    Iterator begin() {
+        Resume(handle_);
+        return Iterator(handle_);
+    }
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    // Every frame starts with a pointer to the FrameBuffer it lives in, or
+    // null for a heap frame; the padding keeps the frame itself aligned.
+    static constexpr std::size_t kFrameHeader = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    static void* WithHeader(void* block, FrameBuffer* buffer) {
+        *static_cast<FrameBuffer**>(block) = buffer;
+        return static_cast<std::byte*>(block) + kFrameHeader;
+    }
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    static void Resume(std::coroutine_handle<promise_type> handle) {
+        handle.resume();
+        if (handle.done() && handle.promise().exception)
+            std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+}
@@ -0,0 +1,209 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "NameIndex/NameIndex.hpp"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace ArgumentParser {
+namespace detail {
+// Levenshtein distance for patterns longer than a machine word.
+ARGPARSER_INLINE std::size_t EditDistanceScalar(std::string_view pattern, std::string_view text) {
+    std::vector<std::size_t> row(pattern.size() + 1);
+    for (std::size_t i = 0; i <= pattern.size(); ++i)
+        row[i] = i;
+    for (std::size_t j = 1; j <= text.size(); ++j) {
+        std::size_t diagonal = row[0];
+        row[0] = j;
+        for (std::size_t i = 1; i <= pattern.size(); ++i) {
+            std::size_t above = row[i];
+            row[i] = std::min({row[i] + 1, row[i - 1] + 1, diagonal + (pattern[i - 1] != text[j - 1])});
+            diagonal = above;
+        }
+    }
+    return row[pattern.size()];
+}
+}
+
+ARGPARSER_INLINE void NameIndex::Build(std::vector<std::string_view> names) {
+    std::erase_if(names, [](std::string_view name) { return name.empty(); });
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    sorted_ = names;
+    nodes_.clear();
+    children_.clear();
+    if (!sorted_.empty())
+        BuildTrie(0, static_cast<uint32_t>(sorted_.size()), 0);
+
+    std::sort(names.begin(), names.end(), [](std::string_view lhs, std::string_view rhs) {
+        return lhs.size() != rhs.size() ? lhs.size() < rhs.size() : lhs < rhs;
+    });
+    by_length_ = std::move(names);
+
+    std::size_t max_length = by_length_.empty() ? 0 : by_length_.back().size();
+    length_offsets_.assign(max_length + 2, 0);
+    for (std::string_view name : by_length_)
+        ++length_offsets_[name.size() + 1];
+    for (std::size_t i = 1; i < length_offsets_.size(); ++i)
+        length_offsets_[i] += length_offsets_[i - 1];
+    is_built_ = true;
+}
+
+ARGPARSER_INLINE void NameIndex::Clear() {
+    sorted_.clear();
+    nodes_.clear();
+    children_.clear();
+    by_length_.clear();
+    length_offsets_.clear();
+    is_built_ = false;
+}
+
+ARGPARSER_INLINE bool NameIndex::IsBuilt() const {
+    return is_built_;
+}
+
+ARGPARSER_INLINE std::vector<std::string_view> NameIndex::Suggest(std::string_view name) const {
+    const std::size_t max_distance = std::clamp<std::size_t>((name.size() + 2) / 3, 1, 3);
+    const std::size_t max_length = length_offsets_.empty() ? 0 : length_offsets_.size() - 2;
+    const std::size_t min_length = name.size() > max_distance ? name.size() - max_distance : 1;
+    const std::size_t last_length = std::min(name.size() + max_distance, max_length);
+
+    PatternMasks peq;
+    peq.Assign(name);
+    std::vector<std::pair<std::size_t, std::string_view>> candidates;
+    for (std::size_t length = min_length; length <= last_length; ++length) {
+        for (std::size_t i = length_offsets_[length]; i < length_offsets_[length + 1]; ++i) {
+            std::size_t distance = peq.pattern.size() == name.size() && !name.empty()
+                                   ? BitParallelDistance(peq, by_length_[i], max_distance)
+                                   : EditDistance(name, by_length_[i], max_distance);
+            if (distance <= max_distance)
+                candidates.emplace_back(distance, by_length_[i]);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    std::vector<std::string_view> suggestions;
+    for (std::size_t i = 0; i < candidates.size() && i < kMaxSuggestions; ++i)
+        suggestions.push_back(candidates[i].second);
+    return suggestions;
+}
+
+// Walks the trie once along the prefix, so the cost is O(prefix length)
+// independent of the number of names. Returns every name starting with
+// the prefix, in sorted order.
+ARGPARSER_INLINE std::span<const std::string_view> NameIndex::FindPrefix(std::string_view prefix) const {
+    if (nodes_.empty())
+        return {};
+
+    const TrieNode* node = &nodes_[0];
+    std::size_t matched = 0;
+    while (true) {
+        std::string_view label = sorted_[node->begin];
+        std::size_t label_end = std::min<std::size_t>(node->depth, prefix.size());
+        for (; matched < label_end; ++matched) {
+            if (label[matched] != prefix[matched])
+                return {};
+        }
+        if (matched == prefix.size())
+            return std::span(sorted_).subspan(node->begin, node->end - node->begin);
+
+        const uint32_t* first = children_.data() + node->children_begin;
+        const uint32_t* last = first + node->children_count;
+        // sorted_ follows char_traits<char> order, which compares bytes as
+        // unsigned char; plain char may be signed.
+        const uint32_t* child = std::lower_bound(first, last, static_cast<unsigned char>(prefix[matched]),
+                                                 [&](uint32_t index, unsigned char symbol) {
+            return static_cast<unsigned char>(sorted_[nodes_[index].begin][matched]) < symbol;
+        });
+        if (child == last || sorted_[nodes_[*child].begin][matched] != prefix[matched])
+            return {};
+        node = &nodes_[*child];
+    }
+}
+
+ARGPARSER_INLINE uint32_t NameIndex::BuildTrie(uint32_t begin, uint32_t end, uint32_t depth) {
+    // In a sorted range the common prefix of all names is the common prefix
+    // of the first and the last one.
+    std::string_view first = sorted_[begin];
+    std::string_view last = sorted_[end - 1];
+    while (depth < first.size() && depth < last.size() && first[depth] == last[depth])
+        ++depth;
+
+    uint32_t index = static_cast<uint32_t>(nodes_.size());
+    nodes_.push_back({begin, end, depth, 0, 0});
+
+    std::vector<uint32_t> children;
+    uint32_t group = begin;
+    if (sorted_[group].size() == depth)
+        ++group;
+    while (group < end) {
+        char symbol = sorted_[group][depth];
+        uint32_t group_end = group;
+        while (group_end < end && sorted_[group_end][depth] == symbol)
+            ++group_end;
+        children.push_back(BuildTrie(group, group_end, depth + 1));
+        group = group_end;
+    }
+
+    nodes_[index].children_begin = static_cast<uint32_t>(children_.size());
+    nodes_[index].children_count = static_cast<uint32_t>(children.size());
+    children_.insert(children_.end(), children.begin(), children.end());
+    return index;
+}
+
+// Bit-parallel Levenshtein distance (Myers 1999, in Hyyro's formulation for
+// global distance). Every column of the DP matrix is processed with a handful
+// of word operations; returns a value greater than max_distance as soon as the
+// bound can no longer be met.
+ARGPARSER_INLINE std::size_t NameIndex::EditDistance(std::string_view pattern, std::string_view text, std::size_t max_distance) {
+    if (pattern.empty())
+        return text.size();
+    if (pattern.size() > 64)
+        return detail::EditDistanceScalar(pattern, text);
+
+    PatternMasks peq;
+    peq.Assign(pattern);
+    return BitParallelDistance(peq, text, max_distance);
+}
+
+ARGPARSER_INLINE void NameIndex::PatternMasks::Assign(std::string_view new_pattern) {
+    for (char symbol : pattern)
+        masks[static_cast<unsigned char>(symbol)] = 0;
+    pattern = new_pattern.substr(0, 64);
+    for (std::size_t i = 0; i < pattern.size(); ++i)
+        masks[static_cast<unsigned char>(pattern[i])] |= uint64_t{1} << i;
+}
+
+// Expects a non-empty pattern of at most 64 characters.
+ARGPARSER_INLINE std::size_t NameIndex::BitParallelDistance(const PatternMasks& peq, std::string_view text, 
+                                                            std::size_t max_distance) {
+    std::string_view pattern = peq.pattern;
+    const uint64_t last = uint64_t{1} << (pattern.size() - 1);
+    uint64_t pv = ~uint64_t{0};
+    uint64_t mv = 0;
+    std::size_t score = pattern.size();
+    for (std::size_t j = 0; j < text.size(); ++j) {
+        uint64_t eq = peq.masks[static_cast<unsigned char>(text[j])];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last)
+            ++score;
+        else if (mh & last)
+            --score;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        std::size_t remaining = text.size() - j - 1;
+        if (score > max_distance + remaining)
+            return max_distance + 1;
+    }
+    return score;
+}
+}
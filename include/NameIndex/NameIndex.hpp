@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "ArgParser/Config.hpp"
+
+namespace ArgumentParser {
+// Index over the long option names of a schema, built once and reused on
+// error paths. Names are grouped by length so that a typo only has to be
+// compared against names whose length is within the distance bound, and kept
+// sorted under a compact radix trie for prefix resolution.
+class NameIndex {
+public:
+    static constexpr std::size_t kMaxSuggestions = 3;
+
+    void Build(std::vector<std::string_view> names);
+    void Clear();
+    bool IsBuilt() const;
+
+    std::vector<std::string_view> Suggest(std::string_view name) const;
+    std::span<const std::string_view> FindPrefix(std::string_view prefix) const;
+
+    static std::size_t EditDistance(std::string_view pattern, std::string_view text, std::size_t max_distance);
+
+private:
+    // Match masks of one pattern for the bit-parallel kernel: bit i of
+    // masks[c] is set when pattern[i] == c. Built once per query; Assign
+    // clears only the entries of the previous pattern.
+    struct PatternMasks {
+        std::array<uint64_t, 256> masks{};
+        std::string_view pattern;
+
+        void Assign(std::string_view new_pattern);
+    };
+
+    static std::size_t BitParallelDistance(const PatternMasks& peq, std::string_view text, std::size_t max_distance);
+
+    // Every node covers the contiguous range [begin, end) of sorted_ whose
+    // names share their first `depth` characters.
+    struct TrieNode {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t depth;
+        uint32_t children_begin;
+        uint32_t children_count;
+    };
+
+    uint32_t BuildTrie(uint32_t begin, uint32_t end, uint32_t depth);
+
+    std::vector<std::string_view> sorted_;
+    std::vector<TrieNode> nodes_;
+    std::vector<uint32_t> children_;
+
+    std::vector<std::string_view> by_length_;
+    std::vector<std::size_t> length_offsets_;
+    bool is_built_ = false;
+};
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "NameIndex/NameIndex-inl.hpp"
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace ArgumentParser {
+// Runs `body(begin, end)` over [0, count) split into chunks that a group of
+// worker threads (plus the calling thread) claim one at a time. `body`
+// returns the index of the first failing element in its chunk, or `end` on
+// success. The result is the lowest failing index overall, or `count`;
+// chunks entirely past an already known failure are skipped.
+//
+// Workers are spawned per call rather than kept in a pool: callers only
+// get here for runs of tens of thousands of values, where thread start-up
+// is noise next to the conversion itself, and the parser stays free of
+// background threads. An exception thrown by `body` stops the remaining
+// chunks and is rethrown on the calling thread once all workers joined.
+template<typename Body>
+std::size_t ParallelFor(std::size_t count, std::size_t threads, std::size_t min_chunk, Body body) {
+    std::size_t chunk = std::max(min_chunk, count / (threads * 4) + 1);
+    std::size_t chunk_count = (count + chunk - 1) / chunk;
+    threads = std::min(threads, chunk_count);
+
+    std::atomic<std::size_t> next_chunk{0};
+    std::atomic<std::size_t> first_error{count};
+    std::atomic_flag failed;
+    std::exception_ptr exception;
+    auto worker = [&]() {
+        while (true) {
+            std::size_t begin = next_chunk.fetch_add(1, std::memory_order_relaxed) * chunk;
+            if (begin >= count || begin >= first_error.load(std::memory_order_relaxed))
+                return;
+            std::size_t end = std::min(begin + chunk, count);
+            std::size_t error;
+            try {
+                error = body(begin, end);
+            } catch (...) {
+                if (!failed.test_and_set())
+                    exception = std::current_exception();
+                first_error.store(0, std::memory_order_relaxed);
+                return;
+            }
+            if (error == end)
+                continue;
+            std::size_t current = first_error.load(std::memory_order_relaxed);
+            while (error < current && !first_error.compare_exchange_weak(current, error)) {}
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(threads > 0 ? threads - 1 : 0);
+        for (std::size_t i = 1; i < threads; ++i)
+            workers.emplace_back(worker);
+        worker();
+    }
+    if (exception)
+        std::rethrow_exception(exception);
+    return first_error.load();
+}
+}
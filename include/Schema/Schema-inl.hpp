@@ -0,0 +1,326 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "Schema/Schema.hpp"
+#endif
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "ArgParser/ArgParser.hpp"
+
+namespace ArgumentParser {
+namespace detail {
+ARGPARSER_INLINE uint32_t ToOffset(std::size_t offset) {
+    if (offset > std::numeric_limits<uint32_t>::max())
+        throw std::length_error("Schema exceeds 4 GiB");
+    return static_cast<uint32_t>(offset);
+}
+
+ARGPARSER_INLINE SchemaView::StringRef AppendString(std::vector<std::byte>& blob, std::string_view str) {
+    SchemaView::StringRef ref{ToOffset(blob.size()), ToOffset(str.size())};
+    blob.resize(blob.size() + str.size());
+    if (!str.empty())
+        std::memcpy(blob.data() + ref.offset, str.data(), str.size());
+    return ref;
+}
+
+template<typename T>
+void Write(std::vector<std::byte>& blob, std::size_t offset, const T& value) {
+    std::memcpy(blob.data() + offset, &value, sizeof(T));
+}
+}
+
+ARGPARSER_INLINE bool SchemaView::Attach(std::span<const std::byte> blob) {
+    blob_ = blob;
+    if (blob_.size() < sizeof(Header) || !Validate()) {
+        blob_ = {};
+        return false;
+    }
+    return true;
+}
+
+ARGPARSER_INLINE bool SchemaView::IsAttached() const {
+    return !blob_.empty();
+}
+
+ARGPARSER_INLINE std::span<const std::byte> SchemaView::Data() const {
+    return blob_;
+}
+
+ARGPARSER_INLINE std::size_t SchemaView::Find(std::string_view full_name) const {
+    Header header = Read<Header>(0);
+    std::size_t mask = header.table_size - 1;
+    std::size_t slot = Hash(full_name) & mask;
+    for (std::size_t probe = 0; probe < header.table_size; ++probe) {
+        uint32_t entry = Read<uint32_t>(header.table_offset + slot * sizeof(uint32_t));
+        if (entry == 0)
+            return kNotFound;
+        if (GetString(GetRecord(entry - 1).name) == full_name)
+            return entry - 1;
+        slot = (slot + 1) & mask;
+    }
+    return kNotFound;
+}
+
+ARGPARSER_INLINE std::size_t SchemaView::FindShort(char short_name) const {
+    std::size_t slot = static_cast<unsigned char>(short_name);
+    uint32_t entry = Read<uint32_t>(Read<Header>(0).short_table_offset + slot * sizeof(uint32_t));
+    return entry == 0 ? kNotFound : entry - 1;
+}
+
+ARGPARSER_INLINE std::size_t SchemaView::ArgumentCount() const {
+    return Read<Header>(0).argument_count;
+}
+
+ARGPARSER_INLINE uint64_t SchemaView::Fingerprint() const {
+    return Read<Header>(0).fingerprint;
+}
+
+ARGPARSER_INLINE std::string_view SchemaView::ParserName() const {
+    return GetString(Read<Header>(0).parser_name);
+}
+
+ARGPARSER_INLINE std::string_view SchemaView::HelpName() const {
+    return GetString(Read<Header>(0).help_name);
+}
+
+ARGPARSER_INLINE std::string_view SchemaView::HelpDescription() const {
+    return GetString(Read<Header>(0).help_description);
+}
+
+ARGPARSER_INLINE char SchemaView::HelpShortName() const {
+    return Read<Header>(0).help_short_name;
+}
+
+ARGPARSER_INLINE auto SchemaView::GetRecord(std::size_t index) const -> Record {
+    return Read<Record>(Read<Header>(0).records_offset + index * sizeof(Record));
+}
+
+ARGPARSER_INLINE std::string_view SchemaView::GetString(StringRef ref) const {
+    return {reinterpret_cast<const char*>(blob_.data()) + ref.offset, ref.length};
+}
+
+ARGPARSER_INLINE uint64_t SchemaView::Hash(std::string_view str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (char symbol : str) {
+        hash ^= static_cast<unsigned char>(symbol);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+template<typename T>
+T SchemaView::Read(std::size_t offset) const {
+    T value;
+    std::memcpy(&value, blob_.data() + offset, sizeof(T));
+    return value;
+}
+
+ARGPARSER_INLINE bool SchemaView::IsInBounds(uint64_t offset, uint64_t size) const {
+    return offset <= blob_.size() && size <= blob_.size() - offset;
+}
+
+ARGPARSER_INLINE bool SchemaView::Validate() const {
+    Header header = Read<Header>(0);
+    if (header.magic != kMagic || header.version != kVersion || header.size != blob_.size())
+        return false;
+    if (!std::has_single_bit(header.table_size) || header.table_size <= header.argument_count)
+        return false;
+    if (!IsInBounds(header.records_offset, uint64_t{header.argument_count} * sizeof(Record))
+            || !IsInBounds(header.table_offset, uint64_t{header.table_size} * sizeof(uint32_t))
+            || !IsInBounds(header.short_table_offset, kShortTableSize * sizeof(uint32_t)))
+        return false;
+    for (StringRef ref : {header.parser_name, header.help_name, header.help_description}) {
+        if (!IsInBounds(ref.offset, ref.length))
+            return false;
+    }
+
+    for (std::size_t i = 0; i < header.argument_count; ++i) {
+        Record record = GetRecord(i);
+        if (record.type > static_cast<uint8_t>(ArgumentType::kMap)
+                || record.duplicate_policy > static_cast<uint8_t>(DuplicatePolicy::kError))
+            return false;
+        for (StringRef ref : {record.name, record.description, record.default_value}) {
+            if (!IsInBounds(ref.offset, ref.length))
+                return false;
+        }
+    }
+    for (std::size_t i = 0; i < header.table_size; ++i) {
+        if (Read<uint32_t>(header.table_offset + i * sizeof(uint32_t)) > header.argument_count)
+            return false;
+    }
+    for (std::size_t i = 0; i < kShortTableSize; ++i) {
+        if (Read<uint32_t>(header.short_table_offset + i * sizeof(uint32_t)) > header.argument_count)
+            return false;
+    }
+    return true;
+}
+
+ARGPARSER_INLINE std::string GenerateSchemaSource(std::span<const std::byte> schema, std::string_view variable_name) {
+    constexpr std::string_view kDigits = "0123456789abcdef";
+    std::string source = "alignas(8) inline constexpr unsigned char " 
+                       + std::string(variable_name) + "[] = {";
+    for (std::size_t i = 0; i < schema.size(); ++i) {
+        unsigned byte = static_cast<unsigned>(schema[i]);
+        source += (i % 16 == 0) ? "\n    " : " ";
+        source += "0x";
+        source += kDigits[byte >> 4];
+        source += kDigits[byte & 0xF];
+        source += ',';
+    }
+    source += "\n};\n";
+    return source;
+}
+
+ARGPARSER_INLINE ArgParser::ArgParser(std::span<const std::byte> schema) 
+        : short_help_name_('\0')
+        , has_help_(false) {
+    if (!schema_.Attach(schema))
+        throw std::invalid_argument("Schema is corrupted or has an unsupported version");
+    parser_name_ = schema_.ParserName();
+    full_help_name_ = schema_.HelpName();
+    help_description_ = schema_.HelpDescription();
+    short_help_name_ = schema_.HelpShortName();
+    arguments_.resize(schema_.ArgumentCount());
+}
+
+ARGPARSER_INLINE ArgParser::ArgParser(std::vector<std::byte>&& schema) 
+        : ArgParser(std::span<const std::byte>(schema)) {
+    // Moving keeps the buffer, so the view attached above stays valid.
+    owned_schema_ = std::move(schema);
+}
+
+ARGPARSER_INLINE std::vector<std::byte> ArgParser::FreezeSchema() const {
+    using Header = SchemaView::Header;
+    using Record = SchemaView::Record;
+
+    if (schema_.IsAttached()) {
+        std::span<const std::byte> data = schema_.Data();
+        return {data.begin(), data.end()};
+    }
+
+    Header header{};
+    header.magic = SchemaView::kMagic;
+    header.version = SchemaView::kVersion;
+    header.fingerprint = SchemaFingerprint();
+    header.argument_count = detail::ToOffset(arguments_.size());
+    header.table_size = std::bit_ceil(2 * arguments_.size() + 1);
+    header.records_offset = sizeof(Header);
+    header.table_offset = detail::ToOffset(header.records_offset + arguments_.size() * sizeof(Record));
+    header.short_table_offset = detail::ToOffset(header.table_offset + header.table_size * sizeof(uint32_t));
+    header.help_short_name = short_help_name_;
+
+    std::vector<std::byte> blob(header.short_table_offset + SchemaView::kShortTableSize * sizeof(uint32_t));
+    header.parser_name = detail::AppendString(blob, parser_name_);
+    header.help_name = detail::AppendString(blob, full_help_name_);
+    header.help_description = detail::AppendString(blob, help_description_);
+
+    std::vector<std::string_view> names = GetNames();
+    std::size_t mask = header.table_size - 1;
+    for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        const BaseArgument& argument = *arguments_[i];
+        Record record{};
+        record.name = detail::AppendString(blob, names[i]);
+        record.description = detail::AppendString(blob, GetDescription(names[i]));
+        record.type = static_cast<uint8_t>(argument.GetType());
+        record.min_args = detail::ToOffset(argument.min_args());
+        record.max_args = static_cast<uint32_t>(std::min<std::size_t>(argument.max_args(), UINT32_MAX));
+        record.short_name = GetShortName(names[i]);
+        if (argument.IsMultiValue())
+            record.flags |= SchemaView::kMultiValue;
+        if (argument.IsPositional())
+            record.flags |= SchemaView::kPositional;
+        if (argument.HasDefault()) {
+            record.flags |= SchemaView::kHasDefault;
+            record.default_value = detail::AppendString(blob, argument.GetDefault());
+        }
+        if (argument.IsFromStream()) {
+            record.flags |= SchemaView::kFromStream;
+            record.stream_fd = argument.GetStreamFd();
+            record.stream_delimiter = argument.GetStreamDelimiter();
+        }
+        if (argument.GetType() == ArgumentType::kString) {
+            if (const StringPolicy* policy = dynamic_cast<const StringArg&>(argument).GetPolicy()) {
+                record.flags |= SchemaView::kValidated;
+                if (policy->utf8)
+                    record.flags |= SchemaView::kUtf8;
+                if (policy->no_control)
+                    record.flags |= SchemaView::kNoControl;
+                record.max_length = static_cast<uint32_t>(std::min<std::size_t>(policy->max_length, UINT32_MAX));
+            }
+        }
+        if (argument.GetType() == ArgumentType::kMap) {
+            auto policy = dynamic_cast<const MapArg&>(argument).GetDuplicatePolicy();
+            record.duplicate_policy = static_cast<uint8_t>(policy);
+        }
+        detail::Write(blob, header.records_offset + i * sizeof(Record), record);
+
+        if (names[i].empty())
+            continue;
+        std::size_t slot = SchemaView::Hash(names[i]) & mask;
+        while (true) {
+            std::size_t offset = header.table_offset + slot * sizeof(uint32_t);
+            uint32_t entry;
+            std::memcpy(&entry, blob.data() + offset, sizeof(entry));
+            if (entry == 0) {
+                detail::Write(blob, offset, static_cast<uint32_t>(i + 1));
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        if (record.short_name != '\0') {
+            std::size_t offset = header.short_table_offset 
+                               + static_cast<unsigned char>(record.short_name) * sizeof(uint32_t);
+            detail::Write(blob, offset, static_cast<uint32_t>(i + 1));
+        }
+    }
+
+    header.size = blob.size();
+    detail::Write(blob, 0, header);
+    return blob;
+}
+
+ARGPARSER_INLINE auto ArgParser::CreateArgument(std::size_t index) const -> ArgPtr {
+    SchemaView::Record record = schema_.GetRecord(index);
+    if (static_cast<ArgumentType>(record.type) == ArgumentType::kMap)
+        return CreateMapArgument(record);
+    return VisitType(static_cast<ArgumentType>(record.type), [&]<typename T>(std::type_identity<T>) {
+        return CreateArgument<T>(record);
+    });
+}
+
+ARGPARSER_INLINE auto ArgParser::CreateMapArgument(const SchemaView::Record& record) const -> ArgPtr {
+    auto argument = std::make_unique<MapArg>();
+    argument->OnDuplicate(static_cast<DuplicatePolicy>(record.duplicate_policy));
+    return argument;
+}
+
+template<typename T>
+auto ArgParser::CreateArgument(const SchemaView::Record& record) const -> ArgPtr {
+    auto argument = std::make_unique<Argument<T>>();
+    if (record.flags & SchemaView::kMultiValue) {
+        if (record.max_args == UINT32_MAX) {
+            argument->MultiValue(record.min_args);
+        } else {
+            argument->MultiValue(record.min_args, record.max_args);
+        }
+    }
+    if (record.flags & SchemaView::kPositional)
+        argument->Positional();
+    if (record.flags & SchemaView::kFromStream)
+        argument->FromStream(record.stream_fd, record.stream_delimiter);
+    if (record.flags & SchemaView::kHasDefault)
+        argument->Default(ConvertDefault<T>(schema_.GetString(record.default_value)));
+    if constexpr (std::is_same_v<T, std::string>) {
+        if (record.flags & SchemaView::kValidated) {
+            std::size_t max_length = record.max_length == UINT32_MAX ? StringPolicy::kUnlimited : record.max_length;
+            argument->Validate({static_cast<bool>(record.flags & SchemaView::kUtf8), 
+                                static_cast<bool>(record.flags & SchemaView::kNoControl), max_length});
+        }
+    }
+    return argument;
+}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "ArgParser/Config.hpp"
+#include "Argument/Argument.hpp"
+
+namespace ArgumentParser {
+// Read-only view over a frozen parser schema produced by ArgParser::FreezeSchema().
+// The blob holds argument records, an open-addressing name table and a short
+// name table, so a parser can be brought up from it without building any maps.
+// Every reference is an offset from the start of the blob; values use the
+// host byte order.
+class SchemaView {
+public:
+    static constexpr uint32_t kMagic = 0x43535041;
+    static constexpr uint32_t kVersion = 4;
+    static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+    static constexpr std::size_t kShortTableSize = 256;
+
+    struct StringRef {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+        uint64_t size;
+        uint32_t argument_count;
+        uint32_t table_size;
+        uint32_t records_offset;
+        uint32_t table_offset;
+        uint32_t short_table_offset;
+        StringRef parser_name;
+        StringRef help_name;
+        StringRef help_description;
+        char help_short_name;
+        uint8_t reserved[3];
+    };
+
+    struct Record {
+        StringRef name;
+        StringRef description;
+        StringRef default_value;
+        uint32_t min_args;
+        uint32_t max_args;
+        uint32_t max_length;
+        int32_t stream_fd;
+        uint8_t type;
+        uint8_t flags;
+        char short_name;
+        char stream_delimiter;
+        uint8_t duplicate_policy;
+        uint8_t reserved[3];
+    };
+
+    enum RecordFlags : uint8_t {
+        kMultiValue = 1 << 0,
+        kPositional = 1 << 1,
+        kHasDefault = 1 << 2,
+        kFromStream = 1 << 3,
+        kValidated = 1 << 4,
+        kUtf8 = 1 << 5,
+        kNoControl = 1 << 6
+    };
+
+    bool Attach(std::span<const std::byte> blob);
+    bool IsAttached() const;
+    std::span<const std::byte> Data() const;
+
+    std::size_t Find(std::string_view full_name) const;
+    std::size_t FindShort(char short_name) const;
+
+    std::size_t ArgumentCount() const;
+    uint64_t Fingerprint() const;
+    std::string_view ParserName() const;
+    std::string_view HelpName() const;
+    std::string_view HelpDescription() const;
+    char HelpShortName() const;
+
+    Record GetRecord(std::size_t index) const;
+    std::string_view GetString(StringRef ref) const;
+
+    static uint64_t Hash(std::string_view str);
+
+private:
+    template<typename T>
+    T Read(std::size_t offset) const;
+
+    bool IsInBounds(uint64_t offset, uint64_t size) const;
+    bool Validate() const;
+
+    std::span<const std::byte> blob_;
+};
+
+// Renders a frozen schema as a C++ array definition that can be compiled into
+// the program and passed to ArgParser via std::as_bytes(std::span(name)).
+std::string GenerateSchemaSource(std::span<const std::byte> schema, std::string_view variable_name);
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ArgumentParser {
+// Contiguous sequence that keeps up to N elements inside the object and
+// spills to the heap beyond that. Used for argument values, where almost
+// every argument holds a single value or a handful of them.
+template<typename T, std::size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs inline capacity");
+
+public:
+    SmallVector() : data_(InlineData()), capacity_(N) {}
+    SmallVector(const SmallVector& other) : SmallVector() {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+        MoveFrom(other);
+    }
+    SmallVector& operator=(SmallVector other) {
+        clear();
+        MoveFrom(other);
+        return *this;
+    }
+    ~SmallVector() {
+        clear();
+        Release();
+    }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    T* begin() { return data_; }
+    T* end() { return data_ + size_; }
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    T& operator[](std::size_t index) { return data_[index]; }
+    const T& operator[](std::size_t index) const { return data_[index]; }
+    T& back() { return data_[size_ - 1]; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    bool is_inline() const { return data_ == InlineData(); }
+
+    void push_back(T value) {
+        if (size_ == capacity_)
+            Grow(size_ + 1);
+        std::construct_at(data_ + size_, std::move(value));
+        ++size_;
+    }
+
+    void reserve(std::size_t capacity) {
+        if (capacity > capacity_)
+            Grow(capacity);
+    }
+
+    void resize(std::size_t size) {
+        if (size > size_) {
+            reserve(size);
+            std::uninitialized_value_construct(data_ + size_, data_ + size);
+        } else {
+            std::destroy(data_ + size, data_ + size_);
+        }
+        size_ = static_cast<uint32_t>(size);
+    }
+
+    // Grows without initializing the new elements; the caller overwrites
+    // them before reading.
+    void resize_for_overwrite(std::size_t size) {
+        if (size > size_) {
+            reserve(size);
+            std::uninitialized_default_construct(data_ + size_, data_ + size);
+        } else {
+            std::destroy(data_ + size, data_ + size_);
+        }
+        size_ = static_cast<uint32_t>(size);
+    }
+
+    void clear() {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+private:
+    T* InlineData() { return std::launder(reinterpret_cast<T*>(inline_)); }
+    const T* InlineData() const { return std::launder(reinterpret_cast<const T*>(inline_)); }
+
+    void Grow(std::size_t min_capacity) {
+        if (min_capacity > std::numeric_limits<uint32_t>::max())
+            throw std::length_error("SmallVector exceeds 2^32 elements");
+        std::size_t capacity = std::max<std::size_t>(min_capacity, 2 * std::size_t{capacity_});
+        capacity = std::min<std::size_t>(capacity, std::numeric_limits<uint32_t>::max());
+        T* data = std::allocator<T>{}.allocate(capacity);
+        std::uninitialized_move(data_, data_ + size_, data);
+        std::destroy(data_, data_ + size_);
+        Release();
+        data_ = data;
+        capacity_ = static_cast<uint32_t>(capacity);
+    }
+
+    void Release() {
+        if (!is_inline())
+            std::allocator<T>{}.deallocate(data_, capacity_);
+        data_ = InlineData();
+        capacity_ = N;
+    }
+
+    void MoveFrom(SmallVector& other) {
+        if (other.is_inline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.clear();
+            return;
+        }
+        Release();
+        data_ = std::exchange(other.data_, other.InlineData());
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, static_cast<uint32_t>(N));
+    }
+
+    T* data_;
+    uint32_t size_ = 0;
+    uint32_t capacity_;
+    alignas(T) std::byte inline_[N * sizeof(T)];
+};
+}
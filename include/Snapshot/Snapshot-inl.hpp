@@ -0,0 +1,331 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "Snapshot/Snapshot.hpp"
+#endif
+
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#include "ArgParser/ArgParser.hpp"
+
+namespace ArgumentParser {
+namespace detail {
+inline constexpr std::size_t kNotFound = std::numeric_limits<std::size_t>::max();
+
+ARGPARSER_INLINE void Append(std::vector<std::byte>& blob, const void* data, std::size_t size) {
+    std::size_t offset = blob.size();
+    blob.resize(offset + size);
+    if (size > 0)
+        std::memcpy(blob.data() + offset, data, size);
+}
+
+ARGPARSER_INLINE uint32_t ToSnapshotOffset(std::size_t offset) {
+    if (offset > std::numeric_limits<uint32_t>::max())
+        throw std::length_error("Snapshot exceeds 4 GiB");
+    return static_cast<uint32_t>(offset);
+}
+
+template<typename T, typename Getter>
+uint32_t AppendValues(std::vector<std::byte>& blob, std::size_t count, Getter get) {
+    blob.resize((blob.size() + alignof(uint64_t) - 1) & ~(alignof(uint64_t) - 1));
+    uint32_t offset = ToSnapshotOffset(blob.size());
+    if constexpr (std::is_same_v<T, std::string>) {
+        blob.resize(blob.size() + count * sizeof(SnapshotView::StringRecord));
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string value = get(i);
+            SnapshotView::StringRecord record{ToSnapshotOffset(blob.size()), ToSnapshotOffset(value.size())};
+            Append(blob, value.data(), value.size());
+            std::memcpy(blob.data() + offset + i * sizeof(record), &record, sizeof(record));
+        }
+    } else if constexpr (std::is_same_v<T, bool>) {
+        for (std::size_t i = 0; i < count; ++i) {
+            uint8_t value = get(i) ? 1 : 0;
+            Append(blob, &value, sizeof(value));
+        }
+    } else {
+        for (std::size_t i = 0; i < count; ++i) {
+            T value = get(i);
+            Append(blob, &value, sizeof(value));
+        }
+    }
+    return offset;
+}
+
+template<typename T>
+void AppendArgument(std::vector<std::byte>& blob, SnapshotView::Entry& entry, const Argument<T>& argument) {
+    entry.count = ToSnapshotOffset(argument.GetStoredCount());
+    if (argument.IsMultiValue())
+        entry.flags |= SnapshotView::kMultiValue;
+    if (argument.IsSet())
+        entry.flags |= SnapshotView::kIsSet;
+    entry.values_offset = AppendValues<T>(blob, entry.count, [&argument](std::size_t i) {
+        return argument.GetValue(i);
+    });
+    if (argument.HasDefault()) {
+        entry.flags |= SnapshotView::kHasDefault;
+        entry.default_offset = AppendValues<T>(blob, 1, [&argument](std::size_t) {
+            return argument.GetDefaultValue();
+        });
+    }
+}
+
+ARGPARSER_INLINE void AppendMapArgument(std::vector<std::byte>& blob, SnapshotView::Entry& entry, const MapArg& argument) {
+    const FlatMap& values = argument.GetValues();
+    entry.count = ToSnapshotOffset(values.Size());
+    if (argument.IsSet())
+        entry.flags |= SnapshotView::kIsSet;
+    entry.values_offset = AppendValues<std::string>(blob, 2 * values.Size(), [&values](std::size_t i) {
+        auto [key, value] = values.GetEntry(i / 2);
+        return std::string(i % 2 == 0 ? key : value);
+    });
+}
+
+ARGPARSER_INLINE void HashBytes(uint64_t& hash, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+}
+}
+
+ARGPARSER_INLINE bool SnapshotView::Attach(std::span<const std::byte> blob, uint64_t fingerprint, 
+                                           std::span<const EntryLayout> layout) {
+    blob_ = blob;
+    if (blob_.size() < sizeof(Header) || !Validate(layout)
+                                      || Read<Header>(0).fingerprint != fingerprint) {
+        Detach();
+        return false;
+    }
+    return true;
+}
+
+ARGPARSER_INLINE void SnapshotView::Detach() {
+    blob_ = {};
+}
+
+ARGPARSER_INLINE bool SnapshotView::IsAttached() const {
+    return !blob_.empty();
+}
+
+ARGPARSER_INLINE bool SnapshotView::Help() const {
+    return Read<Header>(0).flags & kHelp;
+}
+
+ARGPARSER_INLINE int64_t SnapshotView::GetInt(std::size_t argument, std::size_t index) const {
+    std::size_t offset = FindValue(argument, index, sizeof(int64_t));
+    return offset == detail::kNotFound ? 0 : Read<int64_t>(offset);
+}
+
+ARGPARSER_INLINE uint64_t SnapshotView::GetUnsigned(std::size_t argument, std::size_t index) const {
+    std::size_t offset = FindValue(argument, index, sizeof(uint64_t));
+    return offset == detail::kNotFound ? 0 : Read<uint64_t>(offset);
+}
+
+ARGPARSER_INLINE double SnapshotView::GetDouble(std::size_t argument, std::size_t index) const {
+    std::size_t offset = FindValue(argument, index, sizeof(double));
+    return offset == detail::kNotFound ? 0.0 : Read<double>(offset);
+}
+
+ARGPARSER_INLINE bool SnapshotView::GetFlag(std::size_t argument, std::size_t index) const {
+    std::size_t offset = FindValue(argument, index, sizeof(uint8_t));
+    return offset != detail::kNotFound && Read<uint8_t>(offset) != 0;
+}
+
+ARGPARSER_INLINE std::string_view SnapshotView::GetString(std::size_t argument, std::size_t index) const {
+    std::size_t offset = FindValue(argument, index, sizeof(StringRecord));
+    if (offset == detail::kNotFound)
+        return {};
+    StringRecord record = Read<StringRecord>(offset);
+    return {reinterpret_cast<const char*>(blob_.data()) + record.offset, record.length};
+}
+
+ARGPARSER_INLINE auto SnapshotView::GetMapEntry(std::size_t argument, std::size_t index) const 
+        -> std::pair<std::string_view, std::string_view> {
+    Entry entry = GetEntry(argument);
+    if (index >= entry.count)
+        throw std::out_of_range("Index out of range for map argument");
+    auto read = [this](std::size_t offset) {
+        StringRecord record = Read<StringRecord>(offset);
+        return std::string_view(reinterpret_cast<const char*>(blob_.data()) + record.offset, record.length);
+    };
+    std::size_t offset = entry.values_offset + index * 2 * sizeof(StringRecord);
+    return {read(offset), read(offset + sizeof(StringRecord))};
+}
+
+ARGPARSER_INLINE std::size_t SnapshotView::MapSize(std::size_t argument) const {
+    return GetEntry(argument).count;
+}
+
+ARGPARSER_INLINE std::size_t SnapshotView::ElementSize(uint8_t type) {
+    switch (static_cast<ArgumentType>(type)) {
+        case ArgumentType::kString:
+            return sizeof(StringRecord);
+        case ArgumentType::kInt:
+        case ArgumentType::kDuration:
+            return sizeof(int64_t);
+        case ArgumentType::kFlag:
+            return sizeof(uint8_t);
+        case ArgumentType::kDouble:
+            return sizeof(double);
+        case ArgumentType::kUnsigned:
+        case ArgumentType::kByteSize:
+            return sizeof(uint64_t);
+        case ArgumentType::kMap:
+            return 2 * sizeof(StringRecord);
+    }
+    return 0;
+}
+
+template<typename T>
+T SnapshotView::Read(std::size_t offset) const {
+    T value;
+    std::memcpy(&value, blob_.data() + offset, sizeof(T));
+    return value;
+}
+
+ARGPARSER_INLINE auto SnapshotView::GetEntry(std::size_t argument) const -> Entry {
+    return Read<Entry>(kEntriesOffset + argument * sizeof(Entry));
+}
+
+ARGPARSER_INLINE std::size_t SnapshotView::FindValue(std::size_t argument, std::size_t index, std::size_t element_size) const {
+    Entry entry = GetEntry(argument);
+    if (entry.flags & kMultiValue) {
+        if (index >= entry.count)
+            throw std::out_of_range("Index out of range for multi-value argument");
+        return entry.values_offset + index * element_size;
+    }
+    if (index > 0)
+        throw std::logic_error("Can only retrieve the first value of a single-value argument");
+
+    if (entry.count > 0)
+        return entry.values_offset;
+    if (entry.flags & kHasDefault)
+        return entry.default_offset;
+    return detail::kNotFound;
+}
+
+ARGPARSER_INLINE bool SnapshotView::IsInBounds(uint64_t offset, uint64_t size) const {
+    return offset <= blob_.size() && size <= blob_.size() - offset;
+}
+
+ARGPARSER_INLINE bool SnapshotView::Validate(std::span<const EntryLayout> layout) const {
+    std::size_t argument_count = layout.size();
+    Header header = Read<Header>(0);
+    if (header.magic != kMagic || header.version != kVersion 
+                               || header.size != blob_.size()
+                               || header.argument_count != argument_count
+                               || !IsInBounds(kEntriesOffset, uint64_t{argument_count} * sizeof(Entry)))
+        return false;
+
+    for (std::size_t i = 0; i < argument_count; ++i) {
+        Entry entry = GetEntry(i);
+        if (entry.type != layout[i].type || static_cast<bool>(entry.flags & kMultiValue) != layout[i].multi_value)
+            return false;
+        std::size_t element_size = ElementSize(entry.type);
+        if (element_size == 0 || !IsInBounds(entry.values_offset, uint64_t{entry.count} * element_size))
+            return false;
+        if ((entry.flags & kHasDefault) && !IsInBounds(entry.default_offset, element_size))
+            return false;
+        auto type = static_cast<ArgumentType>(entry.type);
+        if (type != ArgumentType::kString && type != ArgumentType::kMap)
+            continue;
+        std::size_t strings = entry.count * (type == ArgumentType::kMap ? 2 : 1);
+        for (std::size_t j = 0; j < strings; ++j) {
+            StringRecord record = Read<StringRecord>(entry.values_offset + j * sizeof(StringRecord));
+            if (!IsInBounds(record.offset, record.length))
+                return false;
+        }
+        if (entry.flags & kHasDefault) {
+            StringRecord record = Read<StringRecord>(entry.default_offset);
+            if (!IsInBounds(record.offset, record.length))
+                return false;
+        }
+    }
+    return true;
+}
+
+ARGPARSER_INLINE std::vector<std::byte> ArgParser::SaveSnapshot() const {
+    using Header = SnapshotView::Header;
+    using Entry = SnapshotView::Entry;
+
+    std::vector<std::byte> blob(SnapshotView::kEntriesOffset + arguments_.size() * sizeof(Entry));
+    for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        ArgPtr unset = arguments_[i] ? nullptr : CreateArgument(i);
+        const BaseArgument& argument = arguments_[i] ? *arguments_[i] : *unset;
+        Entry entry{};
+        entry.type = static_cast<uint8_t>(argument.GetType());
+        if (argument.GetType() == ArgumentType::kMap) {
+            detail::AppendMapArgument(blob, entry, dynamic_cast<const MapArg&>(argument));
+        } else {
+            VisitType(argument.GetType(), [&]<typename T>(std::type_identity<T>) {
+                detail::AppendArgument(blob, entry, dynamic_cast<const Argument<T>&>(argument));
+            });
+        }
+        std::memcpy(blob.data() + SnapshotView::kEntriesOffset + i * sizeof(Entry), &entry, sizeof(entry));
+    }
+
+    Header header{};
+    header.magic = SnapshotView::kMagic;
+    header.version = SnapshotView::kVersion;
+    header.fingerprint = SchemaFingerprint();
+    header.argument_count = detail::ToSnapshotOffset(arguments_.size());
+    header.flags = Help() ? static_cast<uint32_t>(SnapshotView::kHelp) : 0u;
+    header.size = blob.size();
+    std::memcpy(blob.data(), &header, sizeof(header));
+    return blob;
+}
+
+ARGPARSER_INLINE bool ArgParser::LoadSnapshot(std::span<const std::byte> blob) {
+    std::vector<SnapshotView::EntryLayout> layout(arguments_.size());
+    for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        layout[i].type = static_cast<uint8_t>(GetArgumentType(i));
+        layout[i].multi_value = arguments_[i] ? arguments_[i]->IsMultiValue()
+                                              : schema_.GetRecord(i).flags & SchemaView::kMultiValue;
+    }
+    if (!snapshot_.Attach(blob, SchemaFingerprint(), layout)) {
+        std::cerr << "Snapshot is corrupted or does not match the parser schema" << std::endl;
+        return false;
+    }
+    has_help_ = snapshot_.Help();
+
+    // Map lookups need the hash table, so map pairs are copied back into
+    // their arguments instead of being read from the blob.
+    for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        if (GetArgumentType(i) != ArgumentType::kMap)
+            continue;
+        auto& argument = dynamic_cast<MapArg&>(*GetArgument(i));
+        argument.ClearValues();
+        for (std::size_t j = 0; j < snapshot_.MapSize(i); ++j) {
+            auto [key, value] = snapshot_.GetMapEntry(i, j);
+            argument.AddPair(key, value);
+        }
+    }
+    return true;
+}
+
+ARGPARSER_INLINE uint64_t ArgParser::SchemaFingerprint() const {
+    if (schema_.IsAttached())
+        return schema_.Fingerprint();
+
+    std::vector<std::string_view> names = GetNames();
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (std::size_t i = 0; i < arguments_.size(); ++i) {
+        const BaseArgument& argument = *arguments_[i];
+        uint8_t traits[] = {
+            static_cast<uint8_t>(argument.GetType()),
+            static_cast<uint8_t>(argument.IsMultiValue()),
+            static_cast<uint8_t>(argument.IsPositional())
+        };
+        uint64_t length = names[i].size();
+        detail::HashBytes(hash, &length, sizeof(length));
+        detail::HashBytes(hash, names[i].data(), names[i].size());
+        detail::HashBytes(hash, traits, sizeof(traits));
+    }
+    return hash;
+}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "ArgParser/Config.hpp"
+
+namespace ArgumentParser {
+// Read-only view over a blob produced by ArgParser::SaveSnapshot().
+// Every reference inside the blob is an offset from its start, so it can be
+// mapped at any address. Values use the host byte order.
+class SnapshotView {
+public:
+    static constexpr uint32_t kMagic = 0x4E535041;
+    static constexpr uint32_t kVersion = 1;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t fingerprint;
+        uint32_t argument_count;
+        uint32_t flags;
+        uint64_t size;
+    };
+
+    struct Entry {
+        uint8_t type;
+        uint8_t flags;
+        uint16_t reserved;
+        uint32_t count;
+        uint32_t values_offset;
+        uint32_t default_offset;
+    };
+
+    struct StringRecord {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    enum HeaderFlags : uint32_t {
+        kHelp = 1 << 0
+    };
+
+    enum EntryFlags : uint8_t {
+        kMultiValue = 1 << 0,
+        kIsSet = 1 << 1,
+        kHasDefault = 1 << 2
+    };
+
+    // What the parser expects in each entry. A blob whose entries disagree
+    // is rejected, since value sizes and bounds follow the entry type.
+    struct EntryLayout {
+        uint8_t type;
+        bool multi_value;
+    };
+
+    static constexpr std::size_t kEntriesOffset = sizeof(Header);
+
+    bool Attach(std::span<const std::byte> blob, uint64_t fingerprint, std::span<const EntryLayout> layout);
+    void Detach();
+    bool IsAttached() const;
+    bool Help() const;
+
+    int64_t GetInt(std::size_t argument, std::size_t index) const;
+    uint64_t GetUnsigned(std::size_t argument, std::size_t index) const;
+    double GetDouble(std::size_t argument, std::size_t index) const;
+    bool GetFlag(std::size_t argument, std::size_t index) const;
+    std::string_view GetString(std::size_t argument, std::size_t index) const;
+    std::pair<std::string_view, std::string_view> GetMapEntry(std::size_t argument, std::size_t index) const;
+    std::size_t MapSize(std::size_t argument) const;
+
+    static std::size_t ElementSize(uint8_t type);
+
+private:
+    template<typename T>
+    T Read(std::size_t offset) const;
+
+    Entry GetEntry(std::size_t argument) const;
+    std::size_t FindValue(std::size_t argument, std::size_t index, std::size_t element_size) const;
+    bool IsInBounds(uint64_t offset, uint64_t size) const;
+    bool Validate(std::span<const EntryLayout> layout) const;
+
+    std::span<const std::byte> blob_;
+};
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "Stream/StreamReader.hpp"
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if __has_include(<unistd.h>)
+#include <unistd.h>
+#endif
+
+namespace ArgumentParser {
+namespace detail {
+// Reads from a file descriptor where POSIX is available. Elsewhere only
+// stdin (fd 0) can be read, through the C stream.
+ARGPARSER_INLINE std::ptrdiff_t ReadDescriptor(int fd, char* data, std::size_t size) {
+#if __has_include(<unistd.h>)
+    return ::read(fd, data, size);
+#else
+    if (fd != 0) {
+        errno = EBADF;
+        return -1;
+    }
+    std::size_t count = std::fread(data, 1, size, stdin);
+    return count == 0 && std::ferror(stdin) ? -1 : static_cast<std::ptrdiff_t>(count);
+#endif
+}
+}
+
+ARGPARSER_INLINE StreamReader::StreamReader(int fd, char delimiter)
+        : buffer_(kChunkSize)
+        , begin_(0), end_(0)
+        , fd_(fd), delimiter_(delimiter)
+        , eof_(false), has_error_(false) {}
+
+ARGPARSER_INLINE bool StreamReader::Next(std::string_view& token) {
+    std::size_t scanned = begin_;
+    while (true) {
+        const void* found = std::memchr(buffer_.data() + scanned, delimiter_, end_ - scanned);
+        if (found) {
+            std::size_t pos = static_cast<const char*>(found) - buffer_.data();
+            token = std::string_view(buffer_.data() + begin_, pos - begin_);
+            begin_ = pos + 1;
+            return true;
+        }
+        if (eof_) {
+            if (begin_ == end_)
+                return false;
+            token = std::string_view(buffer_.data() + begin_, end_ - begin_);
+            begin_ = end_;
+            return true;
+        }
+        scanned = end_ - begin_;
+        if (!Fill())
+            return false;
+    }
+}
+
+ARGPARSER_INLINE bool StreamReader::HasError() const {
+    return has_error_;
+}
+
+ARGPARSER_INLINE bool StreamReader::Fill() {
+    std::size_t pending = end_ - begin_;
+    if (begin_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, pending);
+        begin_ = 0;
+        end_ = pending;
+    }
+    if (buffer_.size() - end_ < kChunkSize / 2)
+        buffer_.resize(buffer_.size() * 2);
+
+    while (true) {
+        std::ptrdiff_t count = detail::ReadDescriptor(fd_, buffer_.data() + end_, buffer_.size() - end_);
+        if (count > 0) {
+            end_ += static_cast<std::size_t>(count);
+            return true;
+        }
+        if (count == 0) {
+            eof_ = true;
+            return true;
+        }
+        if (errno != EINTR) {
+            has_error_ = true;
+            return false;
+        }
+    }
+}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+#include "ArgParser/Config.hpp"
+
+namespace ArgumentParser {
+// Reads delimiter-separated tokens from a file descriptor in large chunks.
+// A token stays valid until the next call to Next(). Without <unistd.h>
+// only stdin (fd 0) is supported; other descriptors report an error.
+class StreamReader {
+public:
+    static constexpr std::size_t kChunkSize = 1 << 16;
+
+    StreamReader(int fd, char delimiter);
+
+    bool Next(std::string_view& token);
+    bool HasError() const;
+
+private:
+    bool Fill();
+
+    std::vector<char> buffer_;
+    std::size_t begin_;
+    std::size_t end_;
+    int fd_;
+    char delimiter_;
+    bool eof_;
+    bool has_error_;
+};
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "Stream/StreamReader-inl.hpp"
+#endif
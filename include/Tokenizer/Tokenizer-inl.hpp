@@ -0,0 +1,99 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "Tokenizer/Tokenizer.hpp"
+#endif
+
+#include <cstring>
+
+namespace ArgumentParser {
+namespace detail {
+ARGPARSER_INLINE bool IsSeparator(char symbol) {
+    switch (symbol) {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case '\v':
+        case '\f':
+        case '\0':
+            return true;
+        default:
+            return false;
+    }
+}
+
+ARGPARSER_INLINE bool IsDoubleQuoteEscapable(char symbol) {
+    return symbol == '"' || symbol == '\\' || symbol == '$' 
+        || symbol == '`' || symbol == '\n';
+}
+}
+
+ARGPARSER_INLINE bool TokenizeCommandLine(std::string& buffer, std::vector<std::string_view>& tokens) {
+    tokens.clear();
+    char* data = buffer.data();
+    const std::size_t size = buffer.size();
+    std::size_t read = 0;
+    while (read < size) {
+        if (detail::IsSeparator(data[read])) {
+            ++read;
+            continue;
+        }
+
+        const std::size_t begin = read;
+        std::size_t write = read;
+        bool quoted = false;
+        while (read < size && !detail::IsSeparator(data[read])) {
+            char symbol = data[read];
+            if (symbol == '\\') {
+                if (++read == size) {
+                    data[write++] = '\\';
+                    break;
+                }
+                if (data[read] != '\n')
+                    data[write++] = data[read];
+                ++read;
+            } else if (symbol == '\'') {
+                quoted = true;
+                const std::size_t close = buffer.find('\'', read + 1);
+                if (close == std::string::npos)
+                    return false;
+                const std::size_t length = close - read - 1;
+                std::memmove(data + write, data + read + 1, length);
+                write += length;
+                read = close + 1;
+            } else if (symbol == '"') {
+                quoted = true;
+                ++read;
+                while (true) {
+                    if (read == size)
+                        return false;
+                    symbol = data[read];
+                    if (symbol == '"') {
+                        ++read;
+                        break;
+                    }
+                    if (symbol == '\\' && read + 1 < size && detail::IsDoubleQuoteEscapable(data[read + 1])) {
+                        if (data[read + 1] != '\n')
+                            data[write++] = data[read + 1];
+                        read += 2;
+                        continue;
+                    }
+                    data[write++] = symbol;
+                    ++read;
+                }
+            } else {
+                if (write != read)
+                    data[write] = symbol;
+                ++write;
+                ++read;
+            }
+        }
+        // A word made only of line continuations is no word at all, while
+        // '' and "" are explicit empty arguments.
+        if (write != begin || quoted)
+            tokens.emplace_back(data + begin, write - begin);
+    }
+    return true;
+}
+}
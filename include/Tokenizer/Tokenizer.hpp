@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ArgParser/Config.hpp"
+
+namespace ArgumentParser {
+// Splits a command line using POSIX shell quoting rules ('...', "...", \).
+// Tokens are views into `buffer`, which is rewritten in place only where
+// quotes or escapes have to be removed. Whitespace and NUL separate tokens,
+// so runs of separators never produce empty tokens: NUL-delimited input such
+// as /proc/<pid>/cmdline loses its empty arguments unless they are quoted.
+// Returns false on an unterminated quote.
+bool TokenizeCommandLine(std::string& buffer, std::vector<std::string_view>& tokens);
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "Tokenizer/Tokenizer-inl.hpp"
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+
+#ifndef ARGPARSER_HEADER_ONLY
+#include "Validation/Validation.hpp"
+#endif
+
+#include <bit>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ArgumentParser {
+namespace detail {
+ARGPARSER_INLINE bool IsControl(unsigned char byte) {
+    return byte < 0x20 || byte == 0x7F;
+}
+
+// Length of the well-formed UTF-8 sequence starting at `i`, or 0.
+ARGPARSER_INLINE std::size_t SequenceLength(std::string_view value, std::size_t i) {
+    auto byte = [&](std::size_t k) -> unsigned char {
+        return i + k < value.size() ? static_cast<unsigned char>(value[i + k]) : 0;
+    };
+    unsigned char lead = byte(0);
+    unsigned char lower = 0x80;
+    unsigned char upper = 0xBF;
+    std::size_t length;
+    if (lead < 0x80) {
+        return 1;
+    } else if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0)
+            lower = 0xA0;
+        if (lead == 0xED)
+            upper = 0x9F;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0)
+            lower = 0x90;
+        if (lead == 0xF4)
+            upper = 0x8F;
+    } else {
+        return 0;
+    }
+
+    if (byte(1) < lower || byte(1) > upper)
+        return 0;
+    for (std::size_t k = 2; k < length; ++k) {
+        if ((byte(k) & 0xC0) != 0x80)
+            return 0;
+    }
+    return length;
+}
+
+// Checks the code points starting in [begin, end); the last one may extend
+// past `end`. Returns the position after it, or sets `violation`.
+ARGPARSER_INLINE std::size_t ScanScalar(std::string_view value, std::size_t begin, std::size_t end, 
+                       const StringPolicy& policy, StringViolation& violation) {
+    std::size_t i = begin;
+    while (i < end) {
+        unsigned char lead = value[i];
+        if (policy.no_control && IsControl(lead)) {
+            violation = {StringViolationKind::kControlCharacter, i};
+            return i;
+        }
+        if (!policy.utf8 || lead < 0x80) {
+            ++i;
+            continue;
+        }
+        std::size_t length = SequenceLength(value, i);
+        if (length == 0) {
+            violation = {StringViolationKind::kInvalidUtf8, i};
+            return i;
+        }
+        i += length;
+    }
+    return i;
+}
+
+#if defined(__SSE2__)
+ARGPARSER_INLINE StringViolation ScanSse2(std::string_view value, const StringPolicy& policy) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i control_max = _mm_set1_epi8(0x1F);
+    const __m128i del = _mm_set1_epi8(0x7F);
+    // The high bit of each byte in the result marks a byte the scalar path
+    // has to look at: any non-ASCII byte for UTF-8, any control byte.
+    auto flagged = [&](std::size_t offset) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value.data() + offset));
+        __m128i result = policy.utf8 ? chunk : zero;
+        if (policy.no_control) {
+            __m128i control = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(chunk, control_max), chunk),
+                                           _mm_cmpeq_epi8(chunk, del));
+            result = _mm_or_si128(result, control);
+        }
+        return result;
+    };
+
+    StringViolation violation;
+    std::size_t i = 0;
+    while (i + 16 <= value.size()) {
+        if (i + 64 <= value.size()) {
+            __m128i block = _mm_or_si128(_mm_or_si128(flagged(i), flagged(i + 16)),
+                                         _mm_or_si128(flagged(i + 32), flagged(i + 48)));
+            if (_mm_movemask_epi8(block) == 0) {
+                i += 64;
+                continue;
+            }
+        }
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(flagged(i)));
+        if (mask == 0) {
+            i += 16;
+            continue;
+        }
+        i = ScanScalar(value, i + std::countr_zero(mask), i + 16, policy, violation);
+        if (violation.kind != StringViolationKind::kNone)
+            return violation;
+    }
+    ScanScalar(value, i, value.size(), policy, violation);
+    return violation;
+}
+#endif
+}
+
+ARGPARSER_INLINE StringViolation ValidateString(std::string_view value, const StringPolicy& policy) {
+#if defined(__SSE2__)
+    if (value.size() > policy.max_length)
+        return {StringViolationKind::kTooLong, policy.max_length};
+    if (!policy.utf8 && !policy.no_control)
+        return {};
+    return detail::ScanSse2(value, policy);
+#else
+    return ValidateStringScalar(value, policy);
+#endif
+}
+
+ARGPARSER_INLINE StringViolation ValidateStringScalar(std::string_view value, const StringPolicy& policy) {
+    if (value.size() > policy.max_length)
+        return {StringViolationKind::kTooLong, policy.max_length};
+    StringViolation violation;
+    if (policy.utf8 || policy.no_control)
+        detail::ScanScalar(value, 0, value.size(), policy, violation);
+    return violation;
+}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "ArgParser/Config.hpp"
+
+namespace ArgumentParser {
+// Opt-in checks applied to string values while they are parsed. Control
+// characters are the C0 range (including NUL and tab) and DEL.
+struct StringPolicy {
+    static constexpr std::size_t kUnlimited = static_cast<std::size_t>(-1);
+
+    bool utf8 = false;
+    bool no_control = false;
+    std::size_t max_length = kUnlimited;
+};
+
+enum class StringViolationKind {
+    kNone,
+    kTooLong,
+    kInvalidUtf8,
+    kControlCharacter
+};
+
+struct StringViolation {
+    StringViolationKind kind = StringViolationKind::kNone;
+    std::size_t offset = 0;
+};
+
+// Returns the first violation of `policy` in `value` together with the byte
+// offset of the offending sequence; kTooLong is checked before the contents
+// and reports `max_length`. UTF-8 validation rejects overlong forms,
+// surrogates and code points above U+10FFFF. ValidateString scans 64 bytes
+// per step with SSE2 where available and decodes only non-ASCII and control
+// bytes one at a time; ValidateStringScalar is the portable reference.
+StringViolation ValidateString(std::string_view value, const StringPolicy& policy);
+StringViolation ValidateStringScalar(std::string_view value, const StringPolicy& policy);
+}
+
+#ifdef ARGPARSER_HEADER_ONLY
+#include "Validation/Validation-inl.hpp"
+#endif
@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "Convert.cpp is not compiled in header-only mode"
+#endif
+
+#include "Argument/Convert-inl.hpp"
@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "FlatMap.cpp is not compiled in header-only mode"
+#endif
+
+#include "FlatMap/FlatMap-inl.hpp"
@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "MapArgument.cpp is not compiled in header-only mode"
+#endif
+
+#include "Argument/MapArgument-inl.hpp"
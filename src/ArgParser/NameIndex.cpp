@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "NameIndex.cpp is not compiled in header-only mode"
+#endif
+
+#include "NameIndex/NameIndex-inl.hpp"
@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "Schema.cpp is not compiled in header-only mode"
+#endif
+
+#include "Schema/Schema-inl.hpp"
@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "Snapshot.cpp is not compiled in header-only mode"
+#endif
+
+#include "Snapshot/Snapshot-inl.hpp"
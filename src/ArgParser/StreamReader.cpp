@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "StreamReader.cpp is not compiled in header-only mode"
+#endif
+
+#include "Stream/StreamReader-inl.hpp"
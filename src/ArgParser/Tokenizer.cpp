@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "Tokenizer.cpp is not compiled in header-only mode"
+#endif
+
+#include "Tokenizer/Tokenizer-inl.hpp"
@@ -0,0 +1,5 @@
+#ifdef ARGPARSER_HEADER_ONLY
+#error "Validation.cpp is not compiled in header-only mode"
+#endif
+
+#include "Validation/Validation-inl.hpp"
@@ -1,8 +1,13 @@
 #include <sstream>
 #include <fstream>
+#include <cstdio>
+#include <cstring>
+
+#include <unistd.h>
 
 #include <gtest/gtest.h>
 #include "include/ArgParser/ArgParser.hpp"
+#include "include/Parallel/ParallelFor.hpp"
 
 using namespace ArgumentParser;
 
@@ -209,3 +214,983 @@ TEST(ArgParseTestSuite, MinArgs) {
     parser.AddStringArgument('s', "strings").MultiValue(1);
     ASSERT_TRUE(parser.Parse(SplitString("app -n 1 2 3 -s hello")));
 }
+
+TEST(ArgParserTestSuite, CommandLineTest) {
+    ArgParser parser("My Parser");
+    std::vector<int64_t> values;
+    parser.AddStringArgument('i', "input");
+    parser.AddFlag('f', "flag");
+    parser.AddIntArgument("Param1").MultiValue(1).Positional().StoreValues(values);
+
+    ASSERT_TRUE(parser.ParseCommandLine("app  -i test\t1 2 3 --flag"));
+    ASSERT_EQ(parser.GetStringValue("input"), "test");
+    ASSERT_TRUE(parser.GetFlag("flag"));
+    ASSERT_EQ(values.size(), 3);
+}
+
+TEST(ArgParserTestSuite, CommandLineQuotingTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument("single");
+    parser.AddStringArgument("double");
+    parser.AddStringArgument("escaped");
+    parser.AddStringArgument("empty");
+
+    ASSERT_TRUE(parser.ParseCommandLine(
+        R"(app --single='a "b" \c' --double="x \"y\" \$z \q" --escaped=one\ two --empty '')"));
+    ASSERT_EQ(parser.GetStringValue("single"), R"(a "b" \c)");
+    ASSERT_EQ(parser.GetStringValue("double"), R"(x "y" $z \q)");
+    ASSERT_EQ(parser.GetStringValue("escaped"), "one two");
+    ASSERT_EQ(parser.GetStringValue("empty"), "");
+}
+
+TEST(ArgParserTestSuite, CommandLineNulSeparatedTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument('n', "number");
+
+    ASSERT_TRUE(parser.ParseCommandLine(std::string_view("app\0-n\0" "42\0", 10)));
+    ASSERT_EQ(parser.GetIntValue("number"), 42);
+}
+
+TEST(ArgParserTestSuite, CommandLineContinuationTest) {
+    ArgParser parser("My Parser");
+    std::vector<std::string> files;
+    parser.AddStringArgument("files").MultiValue().Positional().StoreValues(files);
+
+    ASSERT_TRUE(parser.ParseCommandLine("app a \\\n b \\\n"));
+    ASSERT_EQ(files, std::vector<std::string>({"a", "b"}));
+}
+
+TEST(ArgParserTestSuite, CommandLineUnterminatedQuoteTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument("param1");
+
+    ASSERT_FALSE(parser.ParseCommandLine("app --param1='value1"));
+    ASSERT_FALSE(parser.ParseCommandLine("app --param1=\"value1"));
+}
+
+TEST(ArgParserTestSuite, StreamPositionalTest) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::string input = "4\n5\r\n\n6";
+    ASSERT_EQ(write(fds[1], input.data(), input.size()), static_cast<ssize_t>(input.size()));
+    close(fds[1]);
+
+    ArgParser parser("My Parser");
+    std::vector<int64_t> values;
+    parser.AddIntArgument("Param1").MultiValue(1).Positional().FromStream(fds[0]).StoreValues(values);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app 1 2 3 -")));
+    close(fds[0]);
+    ASSERT_EQ(values, std::vector<int64_t>({1, 2, 3, 4, 5, 6}));
+}
+
+TEST(ArgParserTestSuite, LargeStreamIncrementalTest) {
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    const int64_t count = 300000;
+    for (int64_t i = 0; i < count; ++i)
+        std::fprintf(file, "%lld,", static_cast<long long>(i));
+    std::rewind(file);
+
+    ArgParser parser("My Parser");
+    int64_t sum = 0;
+    parser.AddIntArgument("Param1").MultiValue(1).Positional()
+          .FromStream(fileno(file), ',')
+          .OnValue([&sum](const int64_t& value) { sum += value; });
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -")));
+    std::fclose(file);
+    ASSERT_EQ(sum, count * (count - 1) / 2);
+}
+
+TEST(ArgParserTestSuite, InvalidStreamValueTest) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::string input = "1\nabc\n";
+    ASSERT_EQ(write(fds[1], input.data(), input.size()), static_cast<ssize_t>(input.size()));
+    close(fds[1]);
+
+    ArgParser parser("My Parser");
+    parser.AddIntArgument("Param1").MultiValue(1).Positional().FromStream(fds[0]);
+
+    ASSERT_FALSE(parser.Parse(SplitString("app -")));
+    close(fds[0]);
+}
+
+TEST(ArgParserTestSuite, StreamMaxArgsTest) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::string input = "2\n3\n4\n";
+    ASSERT_EQ(write(fds[1], input.data(), input.size()), static_cast<ssize_t>(input.size()));
+    close(fds[1]);
+
+    ArgParser parser("My Parser");
+    std::vector<int64_t> values;
+    parser.AddIntArgument("Param1").MultiValue(1, 2).Positional().FromStream(fds[0]).StoreValues(values);
+
+    ASSERT_FALSE(parser.Parse(SplitString("app 1 -")));
+    close(fds[0]);
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kTooManyValues);
+    ASSERT_EQ(values, std::vector<int64_t>({1, 2}));
+}
+
+TEST(ArgParserTestSuite, SnapshotTest) {
+    ArgParser supervisor("My Parser");
+    supervisor.AddStringArgument('i', "input").MultiValue();
+    supervisor.AddIntArgument("number").Default(7);
+    supervisor.AddIntArgument("Param1").MultiValue(1).Positional();
+    supervisor.AddFlag('f', "flag");
+    supervisor.AddFlag("other").Default(true);
+    supervisor.AddStringArgument("name").Default("default");
+    ASSERT_TRUE(supervisor.Parse(SplitString("app 1 2 3 -i a.txt b.txt -f")));
+    std::vector<std::byte> blob = supervisor.SaveSnapshot();
+
+    ArgParser worker("My Parser");
+    worker.AddStringArgument('i', "input").MultiValue();
+    worker.AddIntArgument("number").Default(7);
+    worker.AddIntArgument("Param1").MultiValue(1).Positional();
+    worker.AddFlag('f', "flag");
+    worker.AddFlag("other").Default(true);
+    worker.AddStringArgument("name").Default("default");
+    ASSERT_TRUE(worker.LoadSnapshot(blob));
+    ASSERT_EQ(worker.GetStringValue("input", 0), "a.txt");
+    ASSERT_EQ(worker.GetStringValue("input", 1), "b.txt");
+    ASSERT_EQ(worker.GetIntValue("number"), 7);
+    ASSERT_EQ(worker.GetIntValue("Param1", 2), 3);
+    ASSERT_TRUE(worker.GetFlag("flag"));
+    ASSERT_TRUE(worker.GetFlag("other"));
+    ASSERT_EQ(worker.GetStringValue("name"), "default");
+    ASSERT_THROW(worker.GetIntValue("Param1", 3), std::out_of_range);
+    ASSERT_THROW(worker.GetIntValue("input"), std::invalid_argument);
+}
+
+TEST(ArgParserTestSuite, SnapshotSchemaMismatchTest) {
+    ArgParser supervisor("My Parser");
+    supervisor.AddIntArgument("number");
+    ASSERT_TRUE(supervisor.Parse(SplitString("app --number=1")));
+    std::vector<std::byte> blob = supervisor.SaveSnapshot();
+
+    ArgParser other("My Parser");
+    other.AddStringArgument("number");
+    ASSERT_FALSE(other.LoadSnapshot(blob));
+
+    ArgParser same("My Parser");
+    same.AddIntArgument("number");
+    ASSERT_FALSE(same.LoadSnapshot(std::span(blob).first(blob.size() - 1)));
+    ASSERT_TRUE(same.LoadSnapshot(blob));
+    ASSERT_EQ(same.GetIntValue("number"), 1);
+}
+
+TEST(ArgParserTestSuite, SnapshotTamperedTypeTest) {
+    ArgParser supervisor("My Parser");
+    supervisor.AddIntArgument("number");
+    supervisor.AddIntArgument("values").MultiValue();
+    ASSERT_TRUE(supervisor.Parse(SplitString("app --number=1 --values=2")));
+    std::vector<std::byte> blob = supervisor.SaveSnapshot();
+
+    auto tamper = [&blob](std::size_t argument, auto change) {
+        std::vector<std::byte> copy = blob;
+        SnapshotView::Entry entry;
+        std::size_t offset = SnapshotView::kEntriesOffset + argument * sizeof(entry);
+        std::memcpy(&entry, copy.data() + offset, sizeof(entry));
+        change(entry);
+        std::memcpy(copy.data() + offset, &entry, sizeof(entry));
+        return copy;
+    };
+
+    ArgParser worker("My Parser");
+    worker.AddIntArgument("number");
+    worker.AddIntArgument("values").MultiValue();
+    ASSERT_FALSE(worker.LoadSnapshot(tamper(0, [&blob](SnapshotView::Entry& entry) {
+        entry.type = static_cast<uint8_t>(ArgumentType::kFlag);
+        entry.values_offset = static_cast<uint32_t>(blob.size() - 1);
+    })));
+    ASSERT_FALSE(worker.LoadSnapshot(tamper(1, [](SnapshotView::Entry& entry) {
+        entry.flags &= ~SnapshotView::kMultiValue;
+    })));
+    ASSERT_TRUE(worker.LoadSnapshot(blob));
+    ASSERT_EQ(worker.GetIntValue("number"), 1);
+    ASSERT_EQ(worker.GetIntValue("values", 0), 2);
+}
+
+TEST(ArgParserTestSuite, FrozenSchemaTest) {
+    ArgParser original("My Parser");
+    original.AddHelp('h', "help", "Some Description about program");
+    original.AddStringArgument('i', "input", "File path for input file");
+    original.AddIntArgument("number", "Some Number").Default(4);
+    original.AddFlag('s', "flag1");
+    original.AddFlag('p', "flag2").Default(true);
+    original.AddIntArgument("Param1").MultiValue(1).Positional();
+    std::vector<std::byte> schema = original.FreezeSchema();
+
+    ArgParser parser(schema);
+    ASSERT_EQ(parser.SchemaFingerprint(), original.SchemaFingerprint());
+    ASSERT_EQ(parser.HelpDescription(), original.HelpDescription());
+    ASSERT_TRUE(parser.Parse(SplitString("app -i test 1 2 3 -s")));
+    ASSERT_EQ(parser.GetStringValue("input"), "test");
+    ASSERT_EQ(parser.GetIntValue("number"), 4);
+    ASSERT_EQ(parser.GetIntValue("Param1", 2), 3);
+    ASSERT_TRUE(parser.GetFlag("flag1"));
+    ASSERT_TRUE(parser.GetFlag("flag2"));
+    ASSERT_THROW(parser.AddFlag("flag3"), std::logic_error);
+
+    ArgParser help_parser(schema);
+    ASSERT_TRUE(help_parser.Parse(SplitString("app -h")));
+    ASSERT_TRUE(help_parser.Help());
+}
+
+TEST(ArgParserTestSuite, OwnedFrozenSchemaTest) {
+    ArgParser original("My Parser");
+    original.AddStringArgument('i', "input");
+    original.AddIntArgument("number").Default(4);
+
+    ArgParser parser(original.FreezeSchema());
+    ASSERT_TRUE(parser.Parse(SplitString("app -i test")));
+    ASSERT_EQ(parser.GetStringValue("input"), "test");
+    ASSERT_EQ(parser.GetIntValue("number"), 4);
+    ASSERT_EQ(parser.FreezeSchema(), original.FreezeSchema());
+}
+
+TEST(ArgParserTestSuite, FrozenSchemaErrorsTest) {
+    ArgParser original("My Parser");
+    original.AddStringArgument("param1");
+    original.AddIntArgument('n', "number");
+    std::vector<std::byte> schema = original.FreezeSchema();
+
+    ArgParser parser(schema);
+    ASSERT_FALSE(parser.Parse(SplitString("app --param2=value")));
+    ArgParser missing(schema);
+    ASSERT_FALSE(missing.Parse(SplitString("app --param1=value")));
+    ArgParser invalid(schema);
+    ASSERT_FALSE(invalid.Parse(SplitString("app --param1=value -n abc")));
+
+    schema.pop_back();
+    ASSERT_THROW(ArgParser{schema}, std::invalid_argument);
+    ASSERT_TRUE(GenerateSchemaSource(original.FreezeSchema(), "kSchema")
+                    .starts_with("alignas(8) inline constexpr unsigned char kSchema[] = {\n    0x"));
+}
+
+TEST(ArgParserTestSuite, UnknownArgumentSuggestionTest) {
+    ArgParser parser("My Parser");
+    parser.AddHelp('h', "help", "Some Description about program");
+    parser.AddFlag('v', "verbose");
+    parser.AddFlag("version");
+    parser.AddStringArgument("output");
+    parser.AddStringArgument("outputs");
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --verbos")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kUnknownArgument);
+    ASSERT_EQ(parser.Error().argument, "verbos");
+    ASSERT_EQ(parser.Error().suggestions, std::vector<std::string>({"verbose"}));
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --outpts")));
+    ASSERT_EQ(parser.Error().suggestions, std::vector<std::string>({"outputs", "output"}));
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --hlep")));
+    ASSERT_EQ(parser.Error().suggestions, std::vector<std::string>({"help"}));
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --completely-different")));
+    ASSERT_TRUE(parser.Error().suggestions.empty());
+}
+
+TEST(ArgParserTestSuite, ParseErrorKindTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument('n', "number");
+
+    ASSERT_FALSE(parser.Parse(SplitString("app -n abc")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kInvalidValue);
+    ASSERT_EQ(parser.Error().argument, "number");
+
+    ASSERT_FALSE(parser.Parse(SplitString("app -n")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kMissingValue);
+
+    ASSERT_FALSE(parser.Parse(SplitString("app -x")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kUnknownArgument);
+}
+
+TEST(ArgParserTestSuite, EditDistanceTest) {
+    ASSERT_EQ(NameIndex::EditDistance("kitten", "sitting", 10), 3);
+    ASSERT_EQ(NameIndex::EditDistance("verbose", "verbose", 10), 0);
+    ASSERT_EQ(NameIndex::EditDistance("abc", "", 10), 3);
+    ASSERT_GT(NameIndex::EditDistance("abcdef", "uvwxyz", 2), 2);
+
+    std::string long_pattern(70, 'a');
+    std::string long_text(68, 'a');
+    ASSERT_EQ(NameIndex::EditDistance(long_pattern, long_text, 10), 2);
+    ASSERT_EQ(NameIndex::EditDistance(std::string(64, 'b'), std::string(64, 'b') + "c", 10), 1);
+}
+
+TEST(ArgParserTestSuite, AbbreviationTest) {
+    ArgParser parser("My Parser");
+    parser.AddHelp('h', "help", "Some Description about program");
+    parser.AddFlag("verbose");
+    parser.AddFlag("version");
+    parser.AddIntArgument("number").Default(0);
+    parser.AllowAbbreviations();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --verb --num=5")));
+    ASSERT_TRUE(parser.GetFlag("verbose"));
+    ASSERT_FALSE(parser.GetFlag("version"));
+    ASSERT_EQ(parser.GetIntValue("number"), 5);
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --ver")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kAmbiguousArgument);
+    ASSERT_EQ(parser.Error().suggestions, std::vector<std::string>({"verbose", "version"}));
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --he")));
+    ASSERT_TRUE(parser.Help());
+}
+
+TEST(ArgParserTestSuite, AbbreviationEmptyPrefixTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument("number").Default(0);
+    parser.AllowAbbreviations();
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --=5")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kUnknownArgument);
+}
+
+TEST(ArgParserTestSuite, AbbreviationDisabledTest) {
+    ArgParser parser("My Parser");
+    parser.AddFlag("verbose");
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --verb")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kUnknownArgument);
+}
+
+TEST(ArgParserTestSuite, NameIndexPrefixTest) {
+    NameIndex index;
+    index.Build({"input", "inputs", "interval", "output", "in", "zeta"});
+
+    auto collect = [&index](std::string_view prefix) {
+        auto found = index.FindPrefix(prefix);
+        return std::vector<std::string_view>(found.begin(), found.end());
+    };
+    ASSERT_EQ(collect("in"), std::vector<std::string_view>({"in", "input", "inputs", "interval"}));
+    ASSERT_EQ(collect("inp"), std::vector<std::string_view>({"input", "inputs"}));
+    ASSERT_EQ(collect("inputs"), std::vector<std::string_view>({"inputs"}));
+    ASSERT_EQ(collect("o"), std::vector<std::string_view>({"output"}));
+    ASSERT_TRUE(collect("x").empty());
+    ASSERT_TRUE(collect("inputss").empty());
+    ASSERT_EQ(collect("").size(), 6);
+
+    NameIndex utf8;
+    utf8.Build({"ausgabe", "\xC3\xBC" "ber", "\xC3\xBC" "bersicht", "zeit", "\xC3\xA4" "nderung"});
+    auto found = utf8.FindPrefix("\xC3\xBC");
+    ASSERT_EQ(std::vector<std::string_view>(found.begin(), found.end()),
+              std::vector<std::string_view>({"\xC3\xBC" "ber", "\xC3\xBC" "bersicht"}));
+    ASSERT_EQ(utf8.FindPrefix("\xC3\xA4").size(), 1);
+    ASSERT_EQ(utf8.FindPrefix("z").size(), 1);
+}
+
+TEST(ArgParserTestSuite, ParallelPositionalTest) {
+    const int64_t count = 200000;
+    std::vector<std::string> args = {"app", "--flag"};
+    for (int64_t i = 0; i < count; ++i)
+        args.push_back(std::to_string(i * 3 + 7));
+
+    ArgParser parser("My Parser");
+    std::vector<int64_t> values;
+    parser.AddFlag('f', "flag");
+    parser.AddIntArgument("Param1").MultiValue(1).Positional().StoreValues(values);
+    parser.SetConversionThreads(4);
+
+    ASSERT_TRUE(parser.Parse(args));
+    ASSERT_TRUE(parser.GetFlag("flag"));
+    ASSERT_EQ(values.size(), count);
+    for (int64_t i = 0; i < count; ++i)
+        ASSERT_EQ(values[i], i * 3 + 7);
+}
+
+TEST(ArgParserTestSuite, ParallelPositionalErrorTest) {
+    std::vector<std::string> args = {"app"};
+    for (int i = 0; i < 100000; ++i)
+        args.push_back(std::to_string(i));
+    args[90001] = "bad";
+    args[40001] = "1x";
+    args[40000] = "bad";
+
+    ArgParser parser("My Parser");
+    std::vector<int64_t> values;
+    parser.AddIntArgument("Param1").MultiValue(1).Positional().StoreValues(values);
+    parser.SetConversionThreads(8);
+
+    ASSERT_FALSE(parser.Parse(args));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kInvalidValue);
+    ASSERT_EQ(values.size(), 39999);
+    ASSERT_EQ(values.back(), 39998);
+}
+
+TEST(ArgParserTestSuite, ParallelInternalStorageTest) {
+    std::vector<std::string> args = {"app"};
+    for (int i = 0; i < 100000; ++i)
+        args.push_back(std::to_string(i));
+
+    ArgParser parser("My Parser");
+    parser.AddIntArgument("Param1").MultiValue(1).Positional();
+    parser.SetConversionThreads(4);
+
+    ASSERT_TRUE(parser.Parse(args));
+    ASSERT_EQ(parser.GetIntValue("Param1", 0), 0);
+    ASSERT_EQ(parser.GetIntValue("Param1", 99999), 99999);
+}
+
+TEST(ArgParserTestSuite, ParallelForExceptionTest) {
+    std::atomic<std::size_t> processed = 0;
+    auto body = [&processed](std::size_t begin, std::size_t end) {
+        if (begin == 0)
+            throw std::runtime_error("conversion failed");
+        processed += end - begin;
+        return end;
+    };
+
+    ASSERT_THROW(ParallelFor(1 << 16, 4, 1 << 8, body), std::runtime_error);
+    ASSERT_LT(processed.load(), 1 << 16);
+    ASSERT_EQ(ParallelFor(1 << 10, 4, 1 << 8, [](std::size_t, std::size_t end) { return end; }), 1 << 10);
+}
+
+TEST(ArgParserTestSuite, NumericTypesTest) {
+    ArgParser parser("My Parser");
+    std::vector<uint64_t> masks;
+    parser.AddDoubleArgument('r', "ratio");
+    parser.AddUnsignedArgument('m', "mask").MultiValue().StoreValues(masks);
+    parser.AddIntArgument("offset");
+    ASSERT_TRUE(parser.Parse(SplitString("app -r=0.25 --mask=0xff --mask=0b101 -m=18446744073709551615 --offset=-0x10")));
+    ASSERT_DOUBLE_EQ(parser.GetDoubleValue("ratio"), 0.25);
+    ASSERT_EQ(masks, std::vector<uint64_t>({255, 5, 18446744073709551615ULL}));
+    ASSERT_EQ(parser.GetIntValue("offset"), -16);
+
+    ArgParser overflow("My Parser");
+    overflow.AddUnsignedArgument('m', "mask").MultiValue();
+    ASSERT_FALSE(overflow.Parse(SplitString("app --mask=18446744073709551616")));
+    ASSERT_EQ(overflow.Error().kind, ParseErrorKind::kInvalidValue);
+
+    ArgParser trailing("My Parser");
+    trailing.AddIntArgument("offset");
+    ASSERT_FALSE(trailing.Parse(SplitString("app --offset=12abc")));
+    ASSERT_EQ(trailing.Error().argument, "offset");
+}
+
+TEST(ArgParserTestSuite, DurationAndByteSizeTest) {
+    using namespace std::chrono_literals;
+    ArgParser parser("My Parser");
+    parser.AddDurationArgument('t', "timeout");
+    parser.AddDurationArgument("interval").Default(90s);
+    parser.AddByteSizeArgument("buffer").Default(ByteSize{4 << 20});
+    parser.AddByteSizeArgument("limit");
+    ASSERT_TRUE(parser.Parse(SplitString("app -t=1h30m --limit=1.5KiB")));
+    ASSERT_EQ(parser.GetDurationValue("timeout"), 90min);
+    ASSERT_EQ(parser.GetDurationValue("interval"), 90s);
+    ASSERT_EQ(parser.GetByteSizeValue("buffer"), 4 << 20);
+    ASSERT_EQ(parser.GetByteSizeValue("limit"), 1536);
+
+    ArgParser fractional("My Parser");
+    fractional.AddDurationArgument('t', "timeout");
+    fractional.AddByteSizeArgument("limit");
+    ASSERT_TRUE(fractional.Parse(SplitString("app -t=1.5ms --limit=10MB")));
+    ASSERT_EQ(fractional.GetDurationValue("timeout"), 1500us);
+    ASSERT_EQ(fractional.GetByteSizeValue("limit"), 10'000'000);
+
+    ArgParser unitless("My Parser");
+    unitless.AddDurationArgument('t', "timeout");
+    ASSERT_FALSE(unitless.Parse(SplitString("app -t=15")));
+    ASSERT_EQ(unitless.Error().kind, ParseErrorKind::kInvalidValue);
+
+    ArgParser overflow("My Parser");
+    overflow.AddByteSizeArgument("limit");
+    ASSERT_FALSE(overflow.Parse(SplitString("app --limit=16EiB")));
+    ASSERT_EQ(overflow.Error().argument, "limit");
+
+    ArgParser radix("My Parser");
+    radix.AddByteSizeArgument("size").MultiValue();
+    ASSERT_TRUE(radix.Parse(SplitString("app --size=0b101 --size=0B101 --size=0x10 --size=0X10 --size=0B")));
+    ASSERT_EQ(radix.GetByteSizeValue("size", 0), 5);
+    ASSERT_EQ(radix.GetByteSizeValue("size", 1), 5);
+    ASSERT_EQ(radix.GetByteSizeValue("size", 3), 16);
+    ASSERT_EQ(radix.GetByteSizeValue("size", 4), 0);
+
+    std::string help = parser.HelpDescription();
+    ASSERT_NE(help.find("--interval=<duration>,  [default = 90s]"), std::string::npos);
+    ASSERT_NE(help.find("--buffer=<size>,  [default = 4MiB]"), std::string::npos);
+}
+
+TEST(ArgParserTestSuite, FormatValueRoundTripTest) {
+    using namespace std::chrono_literals;
+    std::chrono::nanoseconds durations[] = {0ns, 1ns, 1500us, -2h, 36h, 61s};
+    for (std::chrono::nanoseconds duration : durations) {
+        std::chrono::nanoseconds parsed;
+        ASSERT_TRUE(ConvertValue(FormatValue(duration), parsed));
+        ASSERT_EQ(parsed, duration);
+    }
+    for (uint64_t bytes : {0ULL, 1ULL, 1536ULL, 1ULL << 40, 18446744073709551615ULL}) {
+        ByteSize parsed;
+        ASSERT_TRUE(ConvertValue(FormatValue(ByteSize{bytes}), parsed));
+        ASSERT_EQ(parsed.bytes, bytes);
+    }
+    for (double value : {0.1, -3.5e-300, 1.0 / 3.0}) {
+        double parsed;
+        ASSERT_TRUE(ConvertValue(FormatValue(value), parsed));
+        ASSERT_EQ(parsed, value);
+    }
+}
+
+TEST(ArgParserTestSuite, FrozenNumericDefaultsTest) {
+    using namespace std::chrono_literals;
+    ArgParser original("My Parser");
+    original.AddDoubleArgument("ratio").Default(0.1);
+    original.AddDurationArgument("timeout").Default(250ms);
+    original.AddByteSizeArgument("buffer").Default(ByteSize{1536});
+    std::vector<std::byte> schema = original.FreezeSchema();
+
+    ArgParser parser(schema);
+    ASSERT_TRUE(parser.Parse(SplitString("app")));
+    ASSERT_EQ(parser.GetDoubleValue("ratio"), 0.1);
+    ASSERT_EQ(parser.GetDurationValue("timeout"), 250ms);
+    ASSERT_EQ(parser.GetByteSizeValue("buffer"), 1536);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --timeout=2s")));
+    ArgParser restored(schema);
+    ASSERT_TRUE(restored.LoadSnapshot(parser.SaveSnapshot()));
+    ASSERT_EQ(restored.GetDurationValue("timeout"), 2s);
+    ASSERT_EQ(restored.GetDoubleValue("ratio"), 0.1);
+}
+
+TEST(ArgParserTestSuite, MapArgumentTest) {
+    ArgParser parser("My Parser");
+    parser.AddMapArgument('D', "define");
+    parser.AddMapArgument("set").OnDuplicate(DuplicatePolicy::kFirstWins);
+    parser.AddMapArgument("strict").OnDuplicate(DuplicatePolicy::kError);
+
+    ASSERT_TRUE(parser.Parse(SplitString("app -D CC=gcc --define=CFLAGS=-O2=x -D CC=clang "
+                                         "--set mode=fast --set mode=slow --set empty=")));
+    ASSERT_EQ(parser.GetMapValue("define", "CC"), "clang");
+    ASSERT_EQ(parser.GetMapValue("define", "CFLAGS"), "-O2=x");
+    ASSERT_EQ(parser.GetMapValue("set", "mode"), "fast");
+    ASSERT_EQ(parser.GetMapValue("set", "empty"), "");
+    ASSERT_FALSE(parser.GetMapValue("set", "missing").has_value());
+    ASSERT_TRUE(parser.GetMap("strict").Empty());
+
+    std::vector<std::string_view> keys;
+    for (auto [key, value] : parser.GetMap("define"))
+        keys.push_back(key);
+    ASSERT_EQ(keys, std::vector<std::string_view>({"CC", "CFLAGS"}));
+
+    ASSERT_FALSE(parser.Parse(SplitString("app --strict a=1 --strict a=2")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kDuplicateKey);
+    ASSERT_EQ(parser.Error().argument, "strict");
+    ASSERT_FALSE(parser.Parse(SplitString("app --set novalue")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kInvalidValue);
+}
+
+TEST(ArgParserTestSuite, FlatMapTest) {
+    FlatMap map;
+    const int count = 5000;
+    for (int i = 0; i < count; ++i)
+        ASSERT_TRUE(map.Insert("key" + std::to_string(i), std::to_string(i * 2)));
+    ASSERT_FALSE(map.Insert("key7", "x"));
+    ASSERT_FALSE(map.InsertOrAssign("key8", "y"));
+    ASSERT_EQ(map.Size(), count);
+    ASSERT_EQ(map.Find("key7"), "14");
+    ASSERT_EQ(map.Find("key8"), "y");
+    for (int i = 10; i < count; ++i)
+        ASSERT_EQ(map.Find("key" + std::to_string(i)), std::to_string(i * 2));
+    ASSERT_FALSE(map.Contains("key5000"));
+    ASSERT_EQ(map.GetEntry(count - 1).first, "key4999");
+
+    map.Clear();
+    ASSERT_TRUE(map.Empty());
+    ASSERT_FALSE(map.Contains("key1"));
+    ASSERT_TRUE(map.Insert("key1", "1"));
+    ASSERT_EQ(map.Find("key1"), "1");
+}
+
+TEST(ArgParserTestSuite, FlatMapOverwriteTest) {
+    FlatMap map;
+    ASSERT_TRUE(map.Insert("key", "initial"));
+    ASSERT_TRUE(map.Insert("other", "value"));
+    const char* data = map.Find("key")->data();
+    ASSERT_FALSE(map.InsertOrAssign("key", "short"));
+    ASSERT_EQ(map.Find("key"), "short");
+    ASSERT_EQ(map.Find("key")->data(), data);
+
+    for (int i = 0; i < 100000; ++i) {
+        std::string value = std::to_string(i);
+        ASSERT_FALSE(map.InsertOrAssign("key", i % 2 ? value : value + "-longer"));
+    }
+    ASSERT_EQ(map.Find("key"), "99999");
+    ASSERT_EQ(map.Find("other"), "value");
+    ASSERT_EQ(map.GetEntry(0).first, "key");
+}
+
+TEST(ArgParserTestSuite, MapSnapshotAndSchemaTest) {
+    ArgParser original("My Parser");
+    original.AddMapArgument('D', "define").OnDuplicate(DuplicatePolicy::kError);
+    original.AddFlag('v', "verbose");
+    std::vector<std::byte> schema = original.FreezeSchema();
+
+    ArgParser empty(schema);
+    ASSERT_TRUE(empty.Parse(SplitString("app -v")));
+    ASSERT_TRUE(empty.GetMap("define").Empty());
+
+    ArgParser duplicate(schema);
+    ASSERT_FALSE(duplicate.Parse(SplitString("app -D a=1 -D a=3")));
+    ASSERT_EQ(duplicate.Error().kind, ParseErrorKind::kDuplicateKey);
+
+    ArgParser parser(schema);
+    ASSERT_TRUE(parser.Parse(SplitString("app -v -D a=1 -D b=2")));
+    ArgParser restored(schema);
+    ASSERT_TRUE(restored.LoadSnapshot(parser.SaveSnapshot()));
+    ASSERT_EQ(restored.GetMap("define").Size(), 2);
+    ASSERT_EQ(restored.GetMapValue("define", "a"), "1");
+    ASSERT_EQ(restored.GetMapValue("define", "b"), "2");
+    ASSERT_TRUE(restored.GetFlag("verbose"));
+}
+
+TEST(ArgParserTestSuite, EventsTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument('i', "input");
+    parser.AddFlag('v', "verbose");
+    parser.AddIntArgument("N").MultiValue().Positional();
+
+    std::vector<std::string> storage = SplitString("app -v --input=file.txt 1 2 3 -i x");
+    std::vector<std::string_view> args(storage.begin(), storage.end());
+
+    std::vector<std::string> seen;
+    for (const ParseEvent& event : parser.Events(args)) {
+        if (event.kind == ParseEventKind::kOption) {
+            seen.push_back(std::string(event.name) + "=" + std::string(event.value));
+        } else if (event.kind == ParseEventKind::kPositional) {
+            ASSERT_EQ(event.type, ArgumentType::kInt);
+            for (std::string_view value : event.values)
+                seen.push_back(std::string(event.name) + ":" + std::string(value));
+        }
+    }
+    ASSERT_EQ(seen, std::vector<std::string>({"verbose=", "input=file.txt", "N:1", "N:2", "N:3", "input=x"}));
+    ASSERT_FALSE(parser.GetFlag("verbose"));
+    ASSERT_EQ(parser.GetStringValue("input"), "");
+}
+
+TEST(ArgParserTestSuite, EventsEarlyStopTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument("param");
+    parser.AddHelp('h', "help", "Some Description");
+
+    std::vector<std::string> storage = SplitString("app --param=abc --unknown --param=1");
+    std::vector<std::string_view> args(storage.begin(), storage.end());
+
+    std::vector<ParseEventKind> kinds;
+    for (const ParseEvent& event : parser.Events(args))
+        kinds.push_back(event.kind);
+    ASSERT_EQ(kinds, std::vector<ParseEventKind>({ParseEventKind::kOption, ParseEventKind::kError}));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kUnknownArgument);
+
+    {
+        auto events = parser.Events(args);
+        auto it = events.begin();
+        ASSERT_EQ(it->value, "abc");
+        ASSERT_THROW(parser.Events(args), std::logic_error);
+        ASSERT_THROW(parser.Parse(storage), std::logic_error);
+    }
+
+    storage = SplitString("app --param=1 -h --param=2");
+    args.assign(storage.begin(), storage.end());
+    kinds.clear();
+    for (const ParseEvent& event : parser.Events(args))
+        kinds.push_back(event.kind);
+    ASSERT_EQ(kinds, std::vector<ParseEventKind>({ParseEventKind::kOption, ParseEventKind::kHelp}));
+    ASSERT_FALSE(parser.Help());
+}
+
+TEST(ArgParserTestSuite, FrameBufferTest) {
+    FrameBuffer buffer;
+    void* block = buffer.Acquire(64);
+    ASSERT_NE(block, nullptr);
+    ASSERT_EQ(buffer.Acquire(16), nullptr);
+    buffer.Release();
+    ASSERT_EQ(buffer.Acquire(32), block);
+
+    FrameBuffer copy(buffer);
+    void* copy_block = copy.Acquire(32);
+    ASSERT_NE(copy_block, nullptr);
+    ASSERT_NE(copy_block, block);
+    buffer.Release();
+    copy.Release();
+
+    {
+        FrameBuffer::Scope scope(buffer);
+        ASSERT_EQ(FrameBuffer::TakePending(), &buffer);
+        ASSERT_EQ(FrameBuffer::TakePending(), nullptr);
+    }
+    ASSERT_EQ(FrameBuffer::TakePending(), nullptr);
+}
+
+TEST(ArgParserTestSuite, SmallVectorTest) {
+    SmallVector<std::string, 2> values;
+    values.push_back("a");
+    values.push_back("b");
+    ASSERT_TRUE(values.is_inline());
+    values.push_back(values[0]);
+    ASSERT_FALSE(values.is_inline());
+    ASSERT_EQ(values.size(), 3);
+    ASSERT_EQ(values[2], "a");
+
+    SmallVector<std::string, 2> moved(std::move(values));
+    ASSERT_EQ(moved.size(), 3);
+    ASSERT_TRUE(values.empty());
+    moved.resize(1);
+    SmallVector<std::string, 2> copy(moved);
+    ASSERT_TRUE(copy.is_inline());
+    ASSERT_EQ(copy[0], "a");
+    copy = std::move(moved);
+    ASSERT_EQ(copy.size(), 1);
+}
+
+TEST(ArgParserTestSuite, CompactArgumentTest) {
+    ArgParser parser("My Parser");
+    std::string stored;
+    parser.AddStringArgument("single").Default("fallback");
+    parser.AddStringArgument("target").StoreValue(stored);
+    parser.AddIntArgument("many").MultiValue(2);
+    ASSERT_TRUE(parser.Parse(SplitString("app --target=t --many=1 --many=2 --many=3")));
+    ASSERT_EQ(parser.GetStringValue("single"), "fallback");
+    ASSERT_EQ(stored, "t");
+    ASSERT_EQ(parser.GetIntValue("many", 2), 3);
+
+    ArgParser repeated("My Parser");
+    std::string repeated_stored;
+    repeated.AddStringArgument("single").Default("fallback");
+    repeated.AddStringArgument("target").StoreValue(repeated_stored);
+    repeated.AddIntArgument("many").MultiValue(2);
+    ASSERT_TRUE(repeated.Parse(SplitString("app --single=a --single=b --target=u --many=4 --many=5")));
+    ASSERT_EQ(repeated.GetStringValue("single"), "b");
+    ASSERT_EQ(repeated.GetStringValue("target"), "u");
+    ASSERT_EQ(repeated_stored, "u");
+    ASSERT_EQ(repeated.GetIntValue("many", 1), 5);
+    ASSERT_THROW(repeated.GetIntValue("many", 2), std::out_of_range);
+}
+
+TEST(ArgParserTestSuite, MultiplePositionalTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument("zsource").Positional();
+    parser.AddFlag('f', "flag");
+    parser.AddIntArgument("numbers").MultiValue(1, 3).Positional();
+    parser.AddStringArgument("another").MultiValue().Positional();
+
+    ASSERT_TRUE(parser.Parse(SplitString("app a 1 2 --flag 3 x y")));
+    ASSERT_EQ(parser.GetStringValue("zsource"), "a");
+    ASSERT_EQ(parser.GetIntValue("numbers", 0), 1);
+    ASSERT_EQ(parser.GetIntValue("numbers", 2), 3);
+    ASSERT_EQ(parser.GetStringValue("another", 0), "x");
+    ASSERT_EQ(parser.GetStringValue("another", 1), "y");
+    ASSERT_TRUE(parser.GetFlag("flag"));
+
+    ArgParser single("My Parser");
+    single.AddStringArgument("input").Positional();
+    ASSERT_FALSE(single.Parse(SplitString("app a b")));
+    ASSERT_EQ(single.Error().kind, ParseErrorKind::kUnknownArgument);
+    ASSERT_EQ(single.Error().argument, "b");
+}
+
+TEST(ArgParserTestSuite, PassthroughTest) {
+    ArgParser parser("My Parser");
+    parser.AddFlag('v', "verbose");
+    parser.AddStringArgument("input").Positional();
+
+    std::vector<std::string> args = SplitString("app -v in -- --not-an-option x -v");
+    ASSERT_TRUE(parser.Parse(args));
+    ASSERT_TRUE(parser.GetFlag("verbose"));
+    ASSERT_EQ(parser.GetStringValue("input"), "in");
+    std::span<const std::string_view> rest = parser.Passthrough();
+    ASSERT_EQ(std::vector<std::string_view>(rest.begin(), rest.end()), 
+              std::vector<std::string_view>({"--not-an-option", "x", "-v"}));
+
+    ASSERT_TRUE(parser.ParseCommandLine("app 'in put' -- 'a b' --"));
+    ASSERT_EQ(parser.GetStringValue("input"), "in put");
+    rest = parser.Passthrough();
+    ASSERT_EQ(std::vector<std::string_view>(rest.begin(), rest.end()), 
+              std::vector<std::string_view>({"a b", "--"}));
+
+    ASSERT_TRUE(parser.Parse(SplitString("app other")));
+    ASSERT_TRUE(parser.Passthrough().empty());
+}
+
+TEST(ArgParserTestSuite, ArityTest) {
+    ArgParser original("My Parser");
+    original.AddIntArgument("pair").MultiValue(2, 2);
+    ASSERT_THROW(IntArg().MultiValue(3, 2), std::invalid_argument);
+    ASSERT_NE(original.HelpDescription().find("min args = 2, max args = 2"), std::string::npos);
+
+    std::vector<std::byte> schema = original.FreezeSchema();
+    ArgParser parser(schema);
+    ASSERT_TRUE(parser.Parse(SplitString("app --pair=1 --pair=2")));
+    ASSERT_EQ(parser.GetIntValue("pair", 1), 2);
+
+    ArgParser too_many(schema);
+    ASSERT_FALSE(too_many.Parse(SplitString("app --pair=1 --pair=2 --pair=3")));
+    ASSERT_EQ(too_many.Error().kind, ParseErrorKind::kTooManyValues);
+}
+
+TEST(ArgParserTestSuite, MultiValueRunTest) {
+    ArgParser parser("My Parser");
+    parser.AddIntArgument('n', "numbers").MultiValue();
+    parser.AddFlag('q', "quiet").MultiValue();
+    parser.AddStringArgument("file").Positional();
+
+    std::vector<std::string> storage = SplitString("app --numbers -1 2 3 -q in.txt");
+    std::vector<std::string_view> args(storage.begin(), storage.end());
+    std::vector<std::string> seen;
+    for (const ParseEvent& event : parser.Events(args)) {
+        std::string values;
+        for (std::string_view value : event.values)
+            values += std::string(value) + ",";
+        seen.push_back(std::string(event.name) + ":" + values);
+    }
+    ASSERT_EQ(seen, std::vector<std::string>({"numbers:-1,2,3,", "quiet:", "file:in.txt,"}));
+
+    ASSERT_TRUE(parser.Parse(storage));
+    ASSERT_EQ(parser.GetIntValue("numbers", 0), -1);
+    ASSERT_EQ(parser.GetIntValue("numbers", 2), 3);
+    ASSERT_TRUE(parser.GetFlag("quiet"));
+    ASSERT_EQ(parser.GetStringValue("file"), "in.txt");
+}
+
+TEST(ArgParserTestSuite, StringPolicyTest) {
+    ArgParser parser("My Parser");
+    parser.AddStringArgument('n', "name").Validate({.utf8 = true, .no_control = true});
+    parser.AddStringArgument("tag").Validate({.max_length = 4});
+    parser.AddStringArgument("files").MultiValue().Positional().Validate({.utf8 = true});
+
+    ASSERT_TRUE(parser.Parse(std::vector<std::string>{"app", "--name=Привет, мир", "--tag=abcd", "a", "é"}));
+    ASSERT_EQ(parser.GetStringValue("name"), "Привет, мир");
+
+    ASSERT_FALSE(parser.Parse(std::vector<std::string>{"app", "-n", "ok\x01"}));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kInvalidValue);
+    ASSERT_EQ(parser.Error().argument, "name");
+    ASSERT_EQ(parser.Error().offset, 2);
+
+    ASSERT_FALSE(parser.Parse(std::vector<std::string>{"app", "--name=ab\xC0\xAF"}));
+    ASSERT_EQ(parser.Error().offset, 2);
+
+    ASSERT_FALSE(parser.Parse(std::vector<std::string>{"app", "--tag=abcde"}));
+    ASSERT_EQ(parser.Error().argument, "tag");
+    ASSERT_EQ(parser.Error().offset, 4);
+
+    ASSERT_FALSE(parser.Parse(std::vector<std::string>{"app", "x", "\xED\xA0\x80"}));
+    ASSERT_EQ(parser.Error().argument, "files");
+    ASSERT_EQ(parser.Error().offset, 0);
+
+    std::vector<std::byte> schema = parser.FreezeSchema();
+    ArgParser frozen(schema);
+    ASSERT_FALSE(frozen.Parse(std::vector<std::string>{"app", "--tag=abcde"}));
+    ASSERT_EQ(frozen.Error().offset, 4);
+    ASSERT_FALSE(frozen.Parse(std::vector<std::string>{"app", "--name=\x7F"}));
+    ASSERT_TRUE(frozen.Parse(std::vector<std::string>{"app", "--name=\xF0\x9F\x98\x80", "--tag=ab"}));
+}
+
+TEST(ArgParserTestSuite, ValidateStringTest) {
+    StringPolicy policy{.utf8 = true, .no_control = true};
+    std::string text;
+    for (int i = 0; i < 40; ++i)
+        text += "abcdefgh Жжж €\xF0\x9F\x98\x80";
+    ASSERT_EQ(ValidateString(text, policy).kind, StringViolationKind::kNone);
+
+    std::vector<std::string> bad = {"\xC0\x80", "\xE0\x80\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80",
+                                    "\xF8", "\x80", "\xE2\x82", "\t", std::string(1, '\0')};
+    for (std::size_t position : {0, 15, 16, 63, 64, 100, 255}) {
+        for (const std::string& sequence : bad) {
+            std::string value = std::string(position, 'a') + sequence + std::string(80, 'b');
+            StringViolation simd = ValidateString(value, policy);
+            StringViolation scalar = ValidateStringScalar(value, policy);
+            ASSERT_NE(simd.kind, StringViolationKind::kNone);
+            ASSERT_EQ(simd.kind, scalar.kind);
+            ASSERT_EQ(simd.offset, position);
+            ASSERT_EQ(scalar.offset, position);
+        }
+    }
+
+    ASSERT_EQ(ValidateString("\xFF\x01", {.no_control = true}).offset, 1);
+    ASSERT_EQ(ValidateString("\xFF\x01", {.utf8 = true}).kind, StringViolationKind::kInvalidUtf8);
+    ASSERT_EQ(ValidateString(text, {.max_length = 10}).kind, StringViolationKind::kTooLong);
+}
+
+TEST(ArgParserTestSuite, ResetTest) {
+    ArgParser parser("My Parser");
+    std::vector<int64_t> numbers;
+    parser.AddIntArgument('n', "number").MultiValue(1, 3).StoreValues(numbers);
+    parser.AddStringArgument('o', "output").Default("out.txt");
+    parser.AddFlag('v', "verbose");
+    parser.AddMapArgument('D', "define");
+    parser.AddStringArgument("files").MultiValue().Positional();
+    parser.AddHelp('h', "help", "Some Description");
+
+    for (int round = 0; round < 3; ++round) {
+        ASSERT_TRUE(parser.Parse(SplitString("app -v -n 1 2 3 --output=a.txt -D k=v f1 f2 -- rest")));
+        ASSERT_EQ(numbers, std::vector<int64_t>({1, 2, 3}));
+        ASSERT_TRUE(parser.GetFlag("verbose"));
+        ASSERT_EQ(parser.GetStringValue("output"), "a.txt");
+        ASSERT_EQ(parser.GetMapValue("define", "k"), "v");
+        ASSERT_EQ(parser.GetStringValue("files", 1), "f2");
+        ASSERT_EQ(parser.Passthrough().size(), 1);
+
+        std::size_t capacity = numbers.capacity();
+        parser.Reset();
+        ASSERT_TRUE(numbers.empty());
+        ASSERT_EQ(numbers.capacity(), capacity);
+        ASSERT_TRUE(parser.Passthrough().empty());
+
+        ASSERT_TRUE(parser.Parse(SplitString("app --number=4")));
+        ASSERT_EQ(numbers, std::vector<int64_t>({4}));
+        ASSERT_FALSE(parser.GetFlag("verbose"));
+        ASSERT_EQ(parser.GetStringValue("output"), "out.txt");
+        ASSERT_TRUE(parser.GetMap("define").Empty());
+        ASSERT_THROW(parser.GetStringValue("files", 0), std::out_of_range);
+        parser.Reset();
+    }
+
+    ASSERT_TRUE(parser.Parse(SplitString("app --help")));
+    ASSERT_TRUE(parser.Help());
+    parser.Reset();
+    ASSERT_FALSE(parser.Help());
+
+    ASSERT_FALSE(parser.Parse(SplitString("app")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kNotEnoughValues);
+    parser.Reset();
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kNone);
+}
+
+TEST(ArgParserTestSuite, ResetStoredDefaultTest) {
+    ArgParser fresh("My Parser");
+    int64_t fresh_number = 0;
+    fresh.AddIntArgument('n', "number").Default(5).StoreValue(fresh_number);
+    ASSERT_TRUE(fresh.Parse(SplitString("app")));
+
+    ArgParser reset("My Parser");
+    int64_t reset_number = 0;
+    reset.AddIntArgument('n', "number").Default(5).StoreValue(reset_number);
+    ASSERT_TRUE(reset.Parse(SplitString("app --number=9")));
+    ASSERT_EQ(reset_number, 9);
+    reset.Reset();
+    ASSERT_EQ(reset_number, 9);
+    ASSERT_TRUE(reset.Parse(SplitString("app")));
+
+    ASSERT_EQ(reset_number, fresh_number);
+    ASSERT_EQ(reset.GetIntValue("number"), fresh.GetIntValue("number"));
+    ASSERT_EQ(fresh_number, 5);
+}
+
+TEST(ArgParserTestSuite, ResetFrozenSchemaTest) {
+    ArgParser original("My Parser");
+    original.AddIntArgument("pair").MultiValue(2, 2);
+    original.AddStringArgument('n', "name");
+
+    std::vector<std::byte> schema = original.FreezeSchema();
+    ArgParser parser(schema);
+    for (int round = 0; round < 3; ++round) {
+        ASSERT_TRUE(parser.ParseCommandLine("app --pair=1 --pair=2 -n 'first name'"));
+        ASSERT_EQ(parser.GetIntValue("pair", 1), 2);
+        ASSERT_EQ(parser.GetStringValue("name"), "first name");
+        parser.Reset();
+    }
+    ASSERT_FALSE(parser.Parse(SplitString("app --pair=1 --pair=2")));
+    ASSERT_EQ(parser.Error().kind, ParseErrorKind::kMissingArgument);
+}
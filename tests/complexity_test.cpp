@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "include/ArgParser/ArgParser.hpp"
+
+using namespace ArgumentParser;
+
+/*
+    Тесты на устойчивость к враждебному вводу: для каждого сценария
+    строится argv двух размеров (n и kGrowth * n), и проверяется, что
+    число аллокаций не зависит от размера (кроме амортизированного роста
+    векторов), а при -DARGPARSER_TIMING_TESTS=ON еще и что время разбора
+    растет почти линейно
+*/
+
+namespace {
+std::atomic<std::size_t> allocation_count = 0;
+
+constexpr std::size_t kGrowth = 8;
+// Quadratic growth would give kGrowth * kGrowth; anything below is accepted
+// as near-linear to keep the suite stable on noisy machines.
+constexpr double kTimeSlack = 3.0;
+constexpr double kTimeNoise = 0.005;
+// Amortized vector growth costs O(log n) allocations.
+constexpr std::size_t kAllocationSlack = 64;
+
+struct Measurement {
+    double seconds;
+    std::size_t allocations;
+};
+
+class SilenceErrors {
+public:
+    SilenceErrors() : buffer_(std::cerr.rdbuf(nullptr)) {}
+    ~SilenceErrors() {
+        std::cerr.rdbuf(buffer_);
+        std::cerr.clear();
+    }
+
+private:
+    std::streambuf* buffer_;
+};
+
+// `setup` builds the parser and input outside of the measured region, `run`
+// parses it. The best of several runs is taken to filter out scheduler noise.
+template<typename Input>
+Measurement Measure(const std::function<Input(std::size_t)>& setup,
+                    const std::function<void(Input&)>& run, std::size_t size) {
+    SilenceErrors silence;
+    Measurement best{1e9, 0};
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        Input input = setup(size);
+        std::size_t before = allocation_count;
+        auto start = std::chrono::steady_clock::now();
+        run(input);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best.seconds = std::min(best.seconds, elapsed.count());
+        best.allocations = allocation_count - before;
+    }
+    return best;
+}
+
+template<typename Input>
+void ExpectLinear(const std::function<Input(std::size_t)>& setup,
+                  const std::function<void(Input&)>& run, std::size_t size) {
+    Measurement small = Measure(setup, run, size);
+    Measurement large = Measure(setup, run, size * kGrowth);
+#ifdef ARGPARSER_TIMING_TESTS
+    EXPECT_LE(large.seconds, small.seconds * kGrowth * kTimeSlack + kTimeNoise)
+        << "n = " << size << ": " << small.seconds << "s, n = " << size * kGrowth << ": " << large.seconds << "s";
+#endif
+    EXPECT_LE(large.allocations, small.allocations + kAllocationSlack)
+        << "n = " << size << ": " << small.allocations << " allocations, n = " << size * kGrowth
+        << ": " << large.allocations << " allocations";
+}
+
+struct ArgvInput {
+    std::unique_ptr<ArgParser> parser;
+    std::vector<std::string> args;
+};
+
+struct CommandLineInput {
+    std::unique_ptr<ArgParser> parser;
+    std::string command_line;
+};
+
+std::vector<std::string> SplitArgs(const std::string& line) {
+    std::istringstream iss(line);
+    return {std::istream_iterator<std::string>(iss), std::istream_iterator<std::string>()};
+}
+
+void ParseArgv(ArgvInput& input) {
+    input.parser->Parse(input.args);
+}
+}
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* ptr = std::malloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+
+TEST(ComplexityTestSuite, LongNamedValueTest) {
+    ExpectLinear<ArgvInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddStringArgument('n', "name");
+        return ArgvInput{std::move(parser), {"app", "--name=" + std::string(size, 'x')}};
+    }, ParseArgv, 1 << 16);
+
+    ExpectLinear<ArgvInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddStringArgument('n', "name");
+        return ArgvInput{std::move(parser), {"app", "-n=" + std::string(size, '=')}};
+    }, ParseArgv, 1 << 16);
+}
+
+
+TEST(ComplexityTestSuite, LongUnknownNameTest) {
+    ExpectLinear<ArgvInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddStringArgument("name");
+        parser->AllowAbbreviations();
+        return ArgvInput{std::move(parser), {"app", "--" + std::string(size, 'n') + "=value"}};
+    }, ParseArgv, 1 << 14);
+}
+
+
+TEST(ComplexityTestSuite, HugeShortClusterTest) {
+    ExpectLinear<ArgvInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddFlag('a', "alpha");
+        parser->AddFlag('b', "beta").MultiValue();
+        std::string cluster = "-";
+        for (std::size_t i = 0; i < size; ++i)
+            cluster += i % 2 ? 'a' : 'b';
+        return ArgvInput{std::move(parser), {"app", cluster}};
+    }, ParseArgv, 1 << 12);
+}
+
+
+TEST(ComplexityTestSuite, ManyMultiValueTokensTest) {
+    ExpectLinear<ArgvInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddIntArgument('v', "values").MultiValue();
+        parser->SetConversionThreads(1);
+        std::vector<std::string> args = {"app", "--values"};
+        args.resize(size + 2, "7");
+        return ArgvInput{std::move(parser), std::move(args)};
+    }, ParseArgv, 1 << 13);
+
+    ExpectLinear<ArgvInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddIntArgument('v', "values").MultiValue();
+        parser->AddStringArgument("rest").MultiValue().Positional();
+        std::vector<std::string> args = {"app"};
+        for (std::size_t i = 0; i < size; ++i) {
+            args.push_back(i % 2 ? "--values=1" : "-v=2");
+            args.push_back("x");
+        }
+        return ArgvInput{std::move(parser), std::move(args)};
+    }, ParseArgv, 1 << 12);
+}
+
+
+TEST(ComplexityTestSuite, LongCommandLineTest) {
+    ExpectLinear<CommandLineInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddStringArgument('s', "strings").MultiValue();
+        std::string command_line = "app --strings";
+        for (std::size_t i = 0; i < size; ++i)
+            command_line += i % 2 ? " 'a b'" : " \"c\\\"d\"";
+        return CommandLineInput{std::move(parser), std::move(command_line)};
+    }, [](CommandLineInput& input) {
+        input.parser->ParseCommandLine(input.command_line);
+    }, 1 << 12);
+
+    ExpectLinear<CommandLineInput>([](std::size_t size) {
+        auto parser = std::make_unique<ArgParser>("Complexity");
+        parser->AddStringArgument("value");
+        return CommandLineInput{std::move(parser), "app --value=\"" + std::string(size, '\\') + "\""};
+    }, [](CommandLineInput& input) {
+        input.parser->ParseCommandLine(input.command_line);
+    }, 1 << 16);
+}
+
+
+TEST(ComplexityTestSuite, SteadyStateReparseTest) {
+    ArgParser parser("Complexity");
+    std::vector<int64_t> numbers;
+    parser.AddIntArgument('n', "number").MultiValue().StoreValues(numbers);
+    parser.AddStringArgument('o', "output").Default("out");
+    parser.AddFlag('v', "verbose");
+    parser.AddMapArgument('D', "define");
+    parser.AddStringArgument("files").MultiValue().Positional();
+
+    std::vector<std::string> args = SplitArgs("app -v -n 1 2 3 --output=a -D key=value f1 f2 f3");
+    std::string command_line = "app -v --number=7 -D 'a=b' -- passthrough";
+    for (int warmup = 0; warmup < 2; ++warmup) {
+        ASSERT_TRUE(parser.Parse(args));
+        parser.Reset();
+        ASSERT_TRUE(parser.ParseCommandLine(command_line));
+        parser.Reset();
+    }
+
+    std::size_t before = allocation_count;
+    for (int round = 0; round < 100; ++round) {
+        parser.Parse(args);
+        parser.Reset();
+        parser.ParseCommandLine(command_line);
+        parser.Reset();
+    }
+    ASSERT_EQ(allocation_count - before, 0);
+}
@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "include/ArgParser/ArgParser.hpp"
+
+using namespace ArgumentParser;
+
+namespace {
+void AddArguments(ArgParser& parser, bool abbreviations) {
+    parser.AddStringArgument('s', "string").Default("default");
+    parser.AddIntArgument('i', "int").MultiValue(0, 4);
+    parser.AddUnsignedArgument('u', "unsigned").MultiValue();
+    parser.AddDoubleArgument('d', "double");
+    parser.AddDurationArgument('t', "timeout");
+    parser.AddByteSizeArgument('b', "bytes");
+    parser.AddMapArgument('D', "define").OnDuplicate(DuplicatePolicy::kError);
+    parser.AddFlag('v', "verbose");
+    parser.AddFlag('q', "quiet").MultiValue();
+    parser.AddIntArgument("count").Positional();
+    parser.AddStringArgument("files").MultiValue(0, 8).Positional();
+    parser.AddHelp('h', "help", "Fuzzer");
+    parser.AllowAbbreviations(abbreviations);
+}
+
+std::vector<std::string> SplitTokens(std::string_view input) {
+    std::vector<std::string> tokens = {"app"};
+    std::size_t begin = 0;
+    while (begin <= input.size()) {
+        std::size_t end = input.find('\0', begin);
+        if (end == std::string_view::npos)
+            end = input.size();
+        tokens.emplace_back(input.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return tokens;
+}
+}
+
+// The first byte selects the entry point, the rest is either a raw command
+// line or a list of NUL-separated argv tokens.
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    if (size == 0)
+        return 0;
+    std::uint8_t mode = data[0];
+    std::string_view input(reinterpret_cast<const char*>(data + 1), size - 1);
+
+    ArgParser parser("Fuzzer");
+    AddArguments(parser, mode & 4);
+    switch (mode & 3) {
+        case 0:
+            parser.ParseCommandLine(input);
+            break;
+        case 1:
+            parser.Parse(SplitTokens(input));
+            break;
+        default: {
+            std::vector<std::string> tokens = SplitTokens(input);
+            std::vector<std::string_view> args(tokens.begin(), tokens.end());
+            for (const ParseEvent& event : parser.Events(args))
+                static_cast<void>(event);
+            break;
+        }
+    }
+    return 0;
+}
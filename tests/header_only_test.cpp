@@ -0,0 +1,44 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "include/ArgParser/ArgParser.hpp"
+
+using namespace ArgumentParser;
+
+/*
+    Вторая единица трансляции header-only цели: здесь снова включаются все
+    определения из *-inl.hpp, поэтому любая функция без inline или
+    вспомогательная сущность с внутренним связыванием в них приводит
+    к ошибке линковки или нарушению ODR
+*/
+
+TEST(HeaderOnlyTestSuite, SecondTranslationUnitTest) {
+    using namespace std::chrono_literals;
+    ArgParser original("My Parser");
+    original.AddStringArgument('i', "input").Validate({.utf8 = true});
+    original.AddDurationArgument("timeout").Default(90s);
+    original.AddByteSizeArgument("buffer").Default(ByteSize{1536});
+    original.AddMapArgument('D', "define");
+    original.AddFlag('v', "verbose");
+
+    ArgParser parser(original.FreezeSchema());
+    parser.AllowAbbreviations();
+    ASSERT_TRUE(parser.ParseCommandLine("app --inp='a b' -D k=v --verb"));
+    ASSERT_EQ(parser.GetStringValue("input"), "a b");
+    ASSERT_EQ(parser.GetDurationValue("timeout"), 90s);
+    ASSERT_EQ(parser.GetByteSizeValue("buffer"), 1536);
+    ASSERT_EQ(parser.GetMapValue("define", "k"), "v");
+
+    std::vector<std::byte> schema = parser.FreezeSchema();
+    ArgParser restored(schema);
+    ASSERT_TRUE(restored.LoadSnapshot(parser.SaveSnapshot()));
+    ASSERT_TRUE(restored.GetFlag("verbose"));
+
+    ArgParser typo(schema);
+    ASSERT_FALSE(typo.Parse(std::vector<std::string>{"app", "--verbsoe"}));
+    ASSERT_EQ(typo.Error().suggestions, std::vector<std::string>({"verbose"}));
+    ByteSize size;
+    ASSERT_TRUE(ConvertValue(FormatValue(ByteSize{1536}), size));
+    ASSERT_EQ(size.bytes, 1536);
+}